@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <source_location>
+
+//
+// Counts the heap allocations the calling thread made through operator new,
+// and through counted_malloc for libraries that take their own allocator
+// (ImGui allocates with malloc unless it's handed these through
+// ImGui::SetAllocatorFunctions). The counting functions are only compiled in
+// when the build defines LOCKER_ALLOCATION_COUNTING (see
+// ENABLE_ALLOCATION_COUNTING); otherwise the count is always zero and every
+// check below is trivially true.
+//
+#ifdef LOCKER_ALLOCATION_COUNTING
+std::uint64_t allocation_count();
+void* counted_malloc(std::size_t size, void* userData);
+void counted_free(void* pointer, void* userData);
+void report_scope_allocations(std::uint64_t allocations, std::source_location location);
+#else
+inline std::uint64_t allocation_count() { return 0; }
+inline void report_scope_allocations(std::uint64_t, std::source_location) {}
+#endif
+
+//
+// Logs whatever was allocated inside its scope, for the paths that run every
+// frame and are meant to stay allocation free. It doesn't assert: ImGui grows
+// its buffers whenever a frame draws more than any before it, so a report
+// right after the window grows is expected, one every frame is a regression.
+// tests/FrameAllocationTest.cpp is what holds the table rows to zero.
+//
+class NoAllocationScope
+{
+public:
+    explicit NoAllocationScope(std::source_location scopeLocation = std::source_location::current())
+        : start(allocation_count())
+        , location(scopeLocation)
+    {}
+
+    ~NoAllocationScope()
+    {
+        if (auto const allocations = allocation_count() - start; allocations != 0)
+        {
+            report_scope_allocations(allocations, location);
+        }
+    }
+
+    NoAllocationScope(NoAllocationScope const&) = delete;
+    NoAllocationScope& operator=(NoAllocationScope const&) = delete;
+
+private:
+    std::uint64_t start;
+    std::source_location location;
+};
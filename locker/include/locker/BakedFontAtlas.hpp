@@ -0,0 +1,46 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+struct ImFontAtlas;
+
+struct BakedFontGlyph
+{
+    std::uint32_t codepoint;
+    bool colored;
+    bool visible;
+    float advanceX;
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+};
+
+//
+// A font atlas as ImGui builds it, captured at build time by the
+// font_atlas_baker tool so startup doesn't have to rasterize the font again.
+// The pixels are the atlas's alpha channel, run-length encoded as (count,
+// alpha) byte pairs; the atlas is mostly empty space and the default font
+// is a bitmap font, so the runs are long.
+//
+struct BakedFontAtlas
+{
+    int width;
+    int height;
+    float fontSize;
+    float ascent;
+    float descent;
+    std::array<float, 2> whitePixel;
+    // four UVs per baked anti-aliased line width, like ImFontAtlas::TexUvLines.
+    std::span<float const> lines;
+    std::span<BakedFontGlyph const> glyphs;
+    std::span<std::uint8_t const> pixels;
+};
+
+// defined by the source the baker generates, only linked in with ENABLE_BAKED_FONT_ATLAS.
+extern BakedFontAtlas const BAKED_FONT_ATLAS;
+
+// replaces whatever the atlas holds with the baked font, its pixels decoded straight into the RGBA32 texture data the backend uploads.
+liberror::Result<void> load_baked_font_atlas(ImFontAtlas& atlas, BakedFontAtlas const& baked);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+//
+// Timeline of a single enforcement, from the moment the process source
+// handed over the creation event to the moment the controller saw the
+// process stopped.
+//
+struct EnforcementTrace
+{
+    std::chrono::steady_clock::time_point received {};
+    std::chrono::steady_clock::time_point queued {};
+    std::chrono::steady_clock::time_point issued {};
+    std::chrono::steady_clock::time_point confirmed {};
+};
+
+//
+// One histogram per leg of the enforcement path plus the whole of it, all in
+// nanoseconds: delivery is the hop from the source to the suspension queue,
+// dispatch the wait in the queue and freeze the time from the suspension
+// going out to the process having stopped.
+//
+struct EnforcementLatency
+{
+    LatencyHistogram delivery {};
+    LatencyHistogram dispatch {};
+    LatencyHistogram freeze {};
+    LatencyHistogram total {};
+
+    void record(EnforcementTrace const& trace)
+    {
+        auto const fnNanoseconds = [] (auto duration) {
+            return static_cast<std::uint64_t>(std::max<std::int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+        };
+
+        delivery.record(fnNanoseconds(trace.queued - trace.received));
+        dispatch.record(fnNanoseconds(trace.issued - trace.queued));
+        freeze.record(fnNanoseconds(trace.confirmed - trace.issued));
+        total.record(fnNanoseconds(trace.confirmed - trace.received));
+    }
+};
+
+void log_enforcement_latency(EnforcementLatency const& latency);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "os/process/ProcessInfo.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class EventLogKind : std::uint8_t { STARTED, EXITED, SUSPENDED, SUSPEND_FAILED, RESUMED, RESUME_FAILED };
+
+struct EventLogEntry
+{
+    std::chrono::steady_clock::time_point at {};
+    EventLogKind kind = EventLogKind::STARTED;
+    ProcessId pid = 0;
+    std::string name {};
+};
+
+//
+// The most recent process and enforcement events, oldest first, for the
+// event log panel. It is a ring of a fixed number of entries that are
+// overwritten in place once it is full, so a name that fits in the old
+// one's storage is recorded without touching the heap.
+//
+class EventLog
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 100'000;
+
+    explicit EventLog(std::size_t logCapacity = DEFAULT_CAPACITY);
+
+    void push(EventLogKind kind, ProcessId pid, std::string_view name);
+    void clear();
+
+    std::size_t size() const { return entries.size(); }
+    EventLogEntry const& operator[](std::size_t index) const { return entries[(oldest + index) % entries.size()]; }
+
+    // every event ever pushed, so a view can tell new ones arrived even when the log is full.
+    std::uint64_t total() const { return pushed; }
+
+private:
+    std::vector<EventLogEntry> entries {};
+    std::size_t capacity;
+    std::size_t oldest = 0;
+    std::uint64_t pushed = 0;
+};
+
+char const* to_string(EventLogKind kind);
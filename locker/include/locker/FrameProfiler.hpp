@@ -0,0 +1,94 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// SEARCH runs inside BUILD_UI, EVENTS and RESCAN on the engine thread; SUBMIT is the draw submission part of RENDER; the rest are consecutive on the UI thread.
+enum class ProfilerStage { WAIT, NEW_FRAME, ENGINE_LOCK, BUILD_UI, SEARCH, RENDER, SUBMIT, SWAP, EVENTS, RESCAN, COUNT };
+
+//
+// Rolling per-frame timings for the overlay. Stages are timed with scoped
+// timers from any thread (the engine's event handling and rescans land in
+// whichever frame they happened during), the render call is bracketed by a
+// GL_TIME_ELAPSED query read back a few frames later so it never stalls the
+// pipeline, and the UI thread's allocations are counted per frame when the
+// build counts them (see ENABLE_ALLOCATION_COUNTING).
+//
+class FrameProfiler
+{
+public:
+    static constexpr std::size_t HISTORY = 240;
+    static constexpr std::size_t STAGE_COUNT = static_cast<std::size_t>(ProfilerStage::COUNT);
+
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(FrameProfiler& frameProfiler, ProfilerStage timedStage)
+            : profiler(frameProfiler)
+            , stage(timedStage)
+            , start(std::chrono::steady_clock::now())
+        {}
+
+        ~ScopedTimer() { profiler.add(stage, std::chrono::steady_clock::now() - start); }
+
+        ScopedTimer(ScopedTimer const&) = delete;
+        ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+    private:
+        FrameProfiler& profiler;
+        ProfilerStage stage;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // needs a current GL context, and shutdown() has to run while it still is.
+    FrameProfiler();
+    void shutdown();
+
+    FrameProfiler(FrameProfiler const&) = delete;
+    FrameProfiler& operator=(FrameProfiler const&) = delete;
+
+    [[nodiscard]] ScopedTimer time(ProfilerStage stage) { return { *this, stage }; }
+
+    void add(ProfilerStage stage, std::chrono::steady_clock::duration duration)
+    {
+        pending[static_cast<std::size_t>(stage)].fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()), std::memory_order_relaxed);
+    }
+
+    // bracket the GPU work to be measured; both are no-ops without timer queries.
+    void begin_gpu_timer();
+    void end_gpu_timer();
+
+    // UI thread only, once per frame after the swap.
+    void end_frame();
+
+    // the overlay window itself, toggled with F12.
+    void draw();
+
+private:
+    static constexpr std::size_t GPU_QUERIES = 4;
+
+    void push(std::array<float, HISTORY>& history, float value) { history[cursor] = value; }
+
+    std::array<std::atomic<std::uint64_t>, STAGE_COUNT> pending {};
+    std::array<std::array<float, HISTORY>, STAGE_COUNT> stageHistory {};
+    std::array<float, HISTORY> frameHistory {};
+    std::array<float, HISTORY> gpuHistory {};
+    std::array<float, HISTORY> allocationHistory {};
+    std::size_t cursor = 0;
+
+    std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+    std::uint64_t frameAllocations = 0;
+
+    bool gpuTimers = false;
+    std::array<GLuint, GPU_QUERIES> gpuQueries {};
+    std::array<bool, GPU_QUERIES> gpuQueryIssued {};
+    std::size_t gpuQuery = 0;
+    float lastGpuTime = 0.f;
+
+    bool visible = false;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+//
+// Log-linear histogram in the spirit of HdrHistogram: every power of two is
+// split into a fixed number of linear sub-buckets, so the recorded values keep
+// a constant relative precision (about 6%) from nanoseconds up to minutes
+// with a fixed amount of memory and an O(1) record().
+//
+class LatencyHistogram
+{
+public:
+    static constexpr std::size_t SUB_BUCKET_BITS = 4;
+    static constexpr std::size_t SUB_BUCKETS = 1zu << SUB_BUCKET_BITS;
+    static constexpr std::size_t MAGNITUDES = 48;
+
+    void record(std::uint64_t value)
+    {
+        value = std::min(value, MAXIMUM_TRACKABLE);
+        counts[index_of(value)] += 1;
+        total += 1;
+        sum += value;
+        maximum = std::max(maximum, value);
+    }
+
+    void merge(LatencyHistogram const& that)
+    {
+        for (auto i = 0zu; i < counts.size(); i += 1)
+        {
+            counts[i] += that.counts[i];
+        }
+        total += that.total;
+        sum += that.sum;
+        maximum = std::max(maximum, that.maximum);
+    }
+
+    void reset() { *this = {}; }
+
+    // upper bound of the bucket holding the given percentile, in [0, 100].
+    std::uint64_t percentile(double percentile) const
+    {
+        if (total == 0) return 0;
+
+        auto const wanted = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(total) + 0.5));
+        std::uint64_t seen = 0;
+
+        for (auto i = 0zu; i < counts.size(); i += 1)
+        {
+            seen += counts[i];
+            if (seen >= wanted) return std::min(highest_equivalent_value(i), maximum);
+        }
+
+        return maximum;
+    }
+
+    std::uint64_t count() const { return total; }
+    std::uint64_t max() const { return maximum; }
+    double mean() const { return total == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(total); }
+
+private:
+    static constexpr std::uint64_t MAXIMUM_TRACKABLE = (std::uint64_t { 1 } << (MAGNITUDES + SUB_BUCKET_BITS)) - 1;
+
+    static std::size_t index_of(std::uint64_t value)
+    {
+        auto const width = static_cast<std::size_t>(std::bit_width(value));
+        auto const magnitude = width > SUB_BUCKET_BITS + 1 ? width - (SUB_BUCKET_BITS + 1) : 0;
+        auto const subBucket = static_cast<std::size_t>(value >> magnitude);
+        return magnitude * SUB_BUCKETS + subBucket;
+    }
+
+    static std::uint64_t highest_equivalent_value(std::size_t index)
+    {
+        auto const magnitude = index < 2 * SUB_BUCKETS ? 0 : index / SUB_BUCKETS - 1;
+        auto const subBucket = index - magnitude * SUB_BUCKETS;
+        return ((std::uint64_t { subBucket } + 1) << magnitude) - 1;
+    }
+
+    std::array<std::uint64_t, (MAGNITUDES + 1) * SUB_BUCKETS> counts {};
+    std::uint64_t total = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t maximum = 0;
+};
@@ -1,8 +1,15 @@
 #pragma once
 
+#include "MemoizerStatistics.hpp"
+
+#include <cstddef>
 #include <functional>
+#include <limits>
+#include <memory_resource>
+#include <optional>
 #include <ranges>
 #include <unordered_map>
+#include <vector>
 
 template <class ... Keys>
 struct TupleHasher
@@ -22,32 +29,187 @@ struct TupleHasher
     }
 };
 
-template <class Return, class ... Arguments> class Memoizer;
+//
+// Monotonic arena meant to back short lived memoizers. Memory handed out by
+// the arena is only reclaimed by reset(), which drops everything at once. When
+// a run spills over the backing buffer the buffer is grown to fit, so a
+// long lived (e.g. thread_local) arena stops allocating once it has warmed up.
+//
+class MemoizerArena
+{
+public:
+    explicit MemoizerArena(std::size_t initialCapacity = 64 * 1024)
+        : buffer(initialCapacity)
+    {
+        arena.emplace(buffer.data(), buffer.size(), &upstream);
+    }
+
+    MemoizerArena(MemoizerArena const&) = delete;
+    MemoizerArena& operator=(MemoizerArena const&) = delete;
+
+    std::pmr::memory_resource* resource() { return &*arena; }
+
+    // every memoizer built on top of the arena must be gone by the time this is called.
+    void reset()
+    {
+        arena->release();
+
+        if (upstream.spilled != 0)
+        {
+            auto const capacity = (buffer.size() + upstream.spilled) * 2;
+            arena.reset();
+            buffer = std::vector<std::byte>(capacity);
+            arena.emplace(buffer.data(), buffer.size(), &upstream);
+            upstream.spilled = 0;
+        }
+    }
+
+private:
+    struct SpillResource : std::pmr::memory_resource
+    {
+        std::size_t spilled = 0;
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            spilled += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& that) const noexcept override
+        {
+            return this == &that;
+        }
+    };
+
+    std::vector<std::byte> buffer;
+    SpillResource upstream;
+    std::optional<std::pmr::monotonic_buffer_resource> arena;
+};
+
+template <class Signature, class Function> class Memoizer;
 
-template<class Return, class ... Arguments>
-class Memoizer<Return(Arguments...)>
+//
+// Stores the callable by its concrete type, so recursion never goes through
+// std::function. The callable receives the memoizer itself as its first
+// argument and recurses through it, Y-combinator style:
+//
+//     auto fib = make_memoizer<size_t(size_t)>([] (auto& self, size_t n) -> size_t {
+//         return n < 2 ? n : self(n - 1) + self(n - 2);
+//     });
+//
+// The cache allocates from the given memory resource; pairing it with a
+// MemoizerArena turns its teardown into a no-op.
+//
+template <class Return, class ... Arguments, class Function>
+class Memoizer<Return(Arguments...), Function>
 {
 public:
-    auto& operator=(auto&& functor)
+    explicit Memoizer(Function functor, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : function(std::move(functor))
+        , cache(resource)
+    {}
+
+    Return operator()(Arguments... args)
     {
-        this->function = std::forward<decltype(functor)>(functor);
-        return *this;
+        [[maybe_unused]] auto const timer = recorder.time_call();
+        auto key = std::make_tuple(args...);
+        auto const fnProbeLength = [&] { return cache.bucket_size(cache.bucket(key)); };
+
+        if (auto cached = cache.find(key); cached != cache.end())
+        {
+            recorder.hit(fnProbeLength);
+            return cached->second;
+        }
+
+        recorder.miss(fnProbeLength);
+
+        // the recursive calls may rehash the cache, so no iterator is held across the invocation.
+        auto result = std::invoke(function, *this, args...);
+        cache.emplace(std::move(key), result);
+
+        recorder.held([&] {
+            using Node = typename decltype(cache)::value_type;
+            return cache.size() * (sizeof(Node) + sizeof(void*) + sizeof(std::size_t)) + cache.bucket_count() * sizeof(void*);
+        });
+
+        return result;
     }
 
-    template<typename... Args>
-    auto operator()(Args&&... args)
+    MemoizerStatistics const& statistics() const { return recorder.statistics(); }
+
+private:
+    Function function;
+    [[no_unique_address]] MemoizerStatisticsRecorder recorder;
+    std::pmr::unordered_map<std::tuple<Arguments...>, Return, TupleHasher<Arguments...>> cache;
+};
+
+template <class Signature, class Function>
+auto make_memoizer(Function&& function, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    return Memoizer<Signature, std::decay_t<Function>>(std::forward<Function>(function), resource);
+}
+
+template <class Signature, class Function, class Projection> class DenseMemoizer;
+
+//
+// Memoizer for functions whose arguments map onto a small dense integer
+// domain. The projection turns the arguments into an index in [0, domainSize)
+// and the cache is a flat array, so a lookup is a single load compared
+// against the empty slot marker instead of a hash and a bucket walk.
+//
+template <class Return, class ... Arguments, class Function, class Projection>
+class DenseMemoizer<Return(Arguments...), Function, Projection>
+{
+    static_assert(std::is_arithmetic_v<Return>, "DenseMemoizer reserves the maximum value of Return to mark empty slots");
+
+public:
+    DenseMemoizer(Function functor, Projection projector, std::size_t domainSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : function(std::move(functor))
+        , projection(std::move(projector))
+        , cache(domainSize, empty, resource)
+    {}
+
+    Return operator()(Arguments... args)
     {
-        const auto key = std::make_tuple(args...);
+        [[maybe_unused]] auto const timer = recorder.time_call();
+        auto const index = static_cast<std::size_t>(std::invoke(projection, args...));
 
-        if (cache.find(key) == cache.end())
+        if (auto const cached = cache[index]; cached != empty)
         {
-            cache[key] = std::invoke(function, std::forward<Args>(args)...);
+            recorder.hit([] { return 1; });
+            return cached;
         }
 
-        return cache[key];
+        recorder.miss([] { return 1; });
+
+        auto const result = std::invoke(function, *this, args...);
+        cache[index] = result;
+
+        recorder.held([&] { return cache.capacity() * sizeof(Return); });
+
+        return result;
     }
 
+    MemoizerStatistics const& statistics() const { return recorder.statistics(); }
+
 private:
-    std::function<Return(Arguments...)> function;
-    std::unordered_map<std::tuple<Arguments...>, Return, TupleHasher<Arguments...>> cache;
+    static constexpr auto empty = std::numeric_limits<Return>::max();
+
+    Function function;
+    Projection projection;
+    [[no_unique_address]] MemoizerStatisticsRecorder recorder;
+    std::pmr::vector<Return> cache;
 };
+
+template <class Signature, class Function, class Projection>
+auto make_dense_memoizer(Function&& function, Projection&& projection, std::size_t domainSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    return DenseMemoizer<Signature, std::decay_t<Function>, std::decay_t<Projection>>(
+        std::forward<Function>(function), std::forward<Projection>(projection), domainSize, resource
+    );
+}
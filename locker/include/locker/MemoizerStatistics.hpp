@@ -0,0 +1,122 @@
+#pragma once
+
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+struct MemoizerStatistics
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t probes = 0;
+    std::size_t bytes = 0;
+    LatencyHistogram latency {};
+
+    double hit_ratio() const
+    {
+        auto const lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+
+    double average_probe_length() const
+    {
+        auto const lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(probes) / static_cast<double>(lookups);
+    }
+
+    MemoizerStatistics& operator+=(MemoizerStatistics const& that)
+    {
+        hits += that.hits;
+        misses += that.misses;
+        probes += that.probes;
+        bytes = std::max(bytes, that.bytes);
+        latency.merge(that.latency);
+        return *this;
+    }
+};
+
+void log_memoizer_statistics(std::string_view name, MemoizerStatistics const& statistics);
+
+//
+// What the memoizers use to record their statistics. Unless the build defines
+// LOCKER_MEMOIZER_STATISTICS (see ENABLE_MEMOIZER_STATISTICS) every member is
+// an empty inline function, the probe length and size callbacks are never
+// invoked and the recorder takes no space, so the memoizers compile down to
+// exactly what they were without it.
+//
+#ifdef LOCKER_MEMOIZER_STATISTICS
+
+class MemoizerStatisticsRecorder
+{
+public:
+    class CallTimer
+    {
+    public:
+        explicit CallTimer(MemoizerStatistics& memoizerStatistics)
+            : statistics(memoizerStatistics)
+            , start(std::chrono::steady_clock::now())
+        {}
+
+        ~CallTimer()
+        {
+            auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            statistics.latency.record(static_cast<std::uint64_t>(elapsed.count()));
+        }
+
+        CallTimer(CallTimer const&) = delete;
+        CallTimer& operator=(CallTimer const&) = delete;
+
+    private:
+        MemoizerStatistics& statistics;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    [[nodiscard]] CallTimer time_call() { return CallTimer { data }; }
+
+    void hit(auto&& fnProbeLength)
+    {
+        data.hits += 1;
+        data.probes += static_cast<std::uint64_t>(fnProbeLength());
+    }
+
+    void miss(auto&& fnProbeLength)
+    {
+        data.misses += 1;
+        data.probes += static_cast<std::uint64_t>(fnProbeLength());
+    }
+
+    void held(auto&& fnBytesHeld)
+    {
+        data.bytes = static_cast<std::size_t>(fnBytesHeld());
+    }
+
+    MemoizerStatistics const& statistics() const { return data; }
+
+private:
+    MemoizerStatistics data {};
+};
+
+#else
+
+class MemoizerStatisticsRecorder
+{
+public:
+    struct CallTimer {};
+
+    [[nodiscard]] CallTimer time_call() { return {}; }
+    void hit(auto&&) {}
+    void miss(auto&&) {}
+    void held(auto&&) {}
+
+    MemoizerStatistics const& statistics() const
+    {
+        static MemoizerStatistics const empty {};
+        return empty;
+    }
+};
+
+#endif
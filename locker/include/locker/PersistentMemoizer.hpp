@@ -0,0 +1,209 @@
+#pragma once
+
+#include "MemoizerStatistics.hpp"
+#include "os/memory/MappedFile.hpp"
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+template <class Signature, class Function> class PersistentMemoizer;
+
+//
+// Memoizer whose cache is an open addressing table living inside a memory
+// mapped file. The table is used in place, so a restarted process comes up
+// with every previously computed result and nothing to deserialize. The file
+// starts with a header carrying the caller's schema version and the layout of
+// the stored types; a mismatch, or a file too short for the capacity its
+// header claims, throws the old table away.
+//
+// Keys and results are stored byte for byte, so both have to be trivially
+// copyable and keys must not contain padding (they are hashed and compared as
+// raw bytes).
+//
+template <class Return, class Key, class Function>
+class PersistentMemoizer<Return(Key), Function>
+{
+    static_assert(std::is_trivially_copyable_v<Key> && std::has_unique_object_representations_v<Key>);
+    static_assert(std::is_trivially_copyable_v<Return>);
+
+public:
+    struct Header
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t layout;
+        std::uint64_t capacity;
+        std::uint64_t size;
+    };
+
+    struct Slot
+    {
+        Key key;
+        Return value;
+        bool occupied;
+    };
+
+    static constexpr std::uint64_t MAGIC = 0x4F4D454D4B434F4C; // "LOCKMEMO"
+
+    static liberror::Result<PersistentMemoizer> open(std::filesystem::path const& path, std::uint32_t schemaVersion, Function function, std::size_t initialCapacity)
+    {
+        PersistentMemoizer memoizer { std::move(function), TRY(map_file(path, sizeof(Header))), schemaVersion };
+
+        auto const& current = memoizer.header();
+        if (current.magic != MAGIC || current.version != schemaVersion || current.layout != LAYOUT || !std::has_single_bit(current.capacity)
+            || !fits(memoizer.mappedFile.bytes().size(), current.capacity))
+        {
+            TRY(memoizer.format(std::bit_ceil(std::max<std::size_t>(initialCapacity, 16)), {}));
+        }
+
+        return memoizer;
+    }
+
+    Return operator()(Key const& key)
+    {
+        [[maybe_unused]] auto const timer = recorder.time_call();
+        std::size_t probes = 0;
+
+        if (auto const* slot = find(key, probes); slot->occupied)
+        {
+            recorder.hit([probes] { return probes; });
+            return slot->value;
+        }
+
+        recorder.miss([probes] { return probes; });
+
+        auto const result = std::invoke(function, *this, key);
+
+        // if the file can't grow the result is still correct, it just doesn't get cached.
+        if (header().size * 4 >= header().capacity * 3 && !grow())
+        {
+            return result;
+        }
+
+        // looked up again since the recursive calls may have grown and remapped the table.
+        if (auto* slot = find(key, probes); !slot->occupied)
+        {
+            *slot = { key, result, true };
+            header().size += 1;
+        }
+
+        recorder.held([this] { return mappedFile.bytes().size(); });
+
+        return result;
+    }
+
+    MemoizerStatistics const& statistics() const { return recorder.statistics(); }
+
+    liberror::Result<void> flush() const { return mappedFile.flush(); }
+
+    std::size_t size() const { return header().size; }
+
+private:
+    PersistentMemoizer(Function functor, MappedFile file, std::uint32_t schemaVersion)
+        : function(std::move(functor))
+        , mappedFile(std::move(file))
+        , version(schemaVersion)
+    {}
+
+    static constexpr auto LAYOUT = static_cast<std::uint32_t>((sizeof(Key) << 16) ^ (sizeof(Return) << 4) ^ alignof(Slot));
+
+    static std::size_t required_size(std::size_t capacity)
+    {
+        return sizeof(Header) + alignof(Slot) + capacity * sizeof(Slot);
+    }
+
+    // the same bound as required_size, without overflowing on a capacity read from a corrupt header.
+    static bool fits(std::size_t bytes, std::uint64_t capacity)
+    {
+        return bytes >= required_size(0) && capacity <= (bytes - required_size(0)) / sizeof(Slot);
+    }
+
+    Header& header() const
+    {
+        return *reinterpret_cast<Header*>(mappedFile.bytes().data());
+    }
+
+    Slot* slots() const
+    {
+        auto const offset = (sizeof(Header) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+        return reinterpret_cast<Slot*>(mappedFile.bytes().data() + offset);
+    }
+
+    static std::uint64_t hash(Key const& key)
+    {
+        // FNV-1a over the object representation, it has to be stable across runs.
+        auto const* bytes = reinterpret_cast<unsigned char const*>(&key);
+        std::uint64_t result = 0xCBF29CE484222325;
+        for (auto i = 0zu; i < sizeof(Key); i += 1)
+        {
+            result = (result ^ bytes[i]) * 0x100000001B3;
+        }
+        return result;
+    }
+
+    Slot* find(Key const& key, std::size_t& probes) const
+    {
+        auto const mask = header().capacity - 1;
+        auto* table = slots();
+
+        probes = 0;
+        for (auto index = hash(key) & mask;; index = (index + 1) & mask)
+        {
+            probes += 1;
+            auto& slot = table[index];
+            if (!slot.occupied || std::memcmp(&slot.key, &key, sizeof(Key)) == 0)
+            {
+                return &slot;
+            }
+        }
+    }
+
+    liberror::Result<void> format(std::size_t capacity, std::vector<Slot> const& entries)
+    {
+        TRY(mappedFile.resize(required_size(capacity)));
+
+        std::memset(mappedFile.bytes().data(), 0, mappedFile.bytes().size());
+        header() = { MAGIC, version, LAYOUT, capacity, entries.size() };
+
+        std::size_t probes = 0;
+        for (auto const& entry : entries)
+        {
+            *find(entry.key, probes) = entry;
+        }
+
+        return {};
+    }
+
+    liberror::Result<void> grow()
+    {
+        std::vector<Slot> entries {};
+        entries.reserve(header().size);
+
+        for (auto i = 0zu; i < header().capacity; i += 1)
+        {
+            if (slots()[i].occupied) entries.push_back(slots()[i]);
+        }
+
+        return format(header().capacity * 2, entries);
+    }
+
+    Function function;
+    MappedFile mappedFile;
+    std::uint32_t version;
+    [[no_unique_address]] MemoizerStatisticsRecorder recorder;
+};
+
+template <class Signature, class Function>
+auto make_persistent_memoizer(std::filesystem::path const& path, std::uint32_t schemaVersion, Function&& function, std::size_t initialCapacity = 1024)
+{
+    return PersistentMemoizer<Signature, std::decay_t<Function>>::open(path, schemaVersion, std::forward<Function>(function), initialCapacity);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "EnforcementLatency.hpp"
+#include "EventLog.hpp"
+#include "os/process/ProcessBackend.hpp"
+#include "os/process/ProcessInfo.hpp"
+#include "os/process/ProcessTree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//
+// Processes waiting to be frozen, each with the protected program it gets
+// locked under. That is its own name, or the name of the protected ancestor
+// that started it. A process that fails to suspend is queued again with its
+// attempt count, up to MAX_ATTEMPTS.
+//
+struct SuspensionQueue
+{
+    static constexpr auto MAX_ATTEMPTS = 5;
+
+    std::vector<ProcessInfo> processes {};
+    std::vector<std::string> programs {};
+    std::vector<int> attempts {};
+
+    void push(ProcessInfo process, std::string program, int attempt = 0)
+    {
+        processes.push_back(std::move(process));
+        programs.push_back(std::move(program));
+        attempts.push_back(attempt);
+    }
+
+    void erase(ProcessId pid)
+    {
+        auto const position = std::ranges::find(processes, pid, &ProcessInfo::pid);
+        if (position == processes.end()) return;
+
+        auto const index = std::distance(processes.begin(), position);
+        processes.erase(position);
+        programs.erase(programs.begin() + index);
+        attempts.erase(attempts.begin() + index);
+    }
+
+    bool contains(ProcessId pid) const { return std::ranges::find(processes, pid, &ProcessInfo::pid) != processes.end(); }
+
+    bool empty() const { return processes.empty(); }
+
+    void clear()
+    {
+        processes.clear();
+        programs.clear();
+        attempts.clear();
+    }
+};
+
+struct ProcessListenerContext
+{
+    std::unordered_map<std::string, std::string>& protectedPrograms;
+    std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>>& runningProcesses;
+    ProcessTree& processTree;
+    // found by a rescan before their creation event arrived, which is then nothing new.
+    std::unordered_set<ProcessId>& unannouncedProcesses;
+    SuspensionQueue& suspensionQueue;
+    std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>>& suspendedProcesses;
+    std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>>& resumedProcesses;
+    ProcessControllerBackend& controller;
+    std::unordered_map<ProcessId, EnforcementTrace>& enforcementTraces;
+    EnforcementLatency& enforcementLatency;
+    EventLog& eventLog;
+};
+
+//
+// The engine's side of process events. A rescan handles whatever the events
+// missed, a dropped event or one the source never sent, the same way, so the
+// creations it finds first and the exits it notices first are nothing new
+// once their events do arrive.
+//
+void process_creation_handler(ProcessListenerContext& ctx, ProcessInfo process, std::chrono::steady_clock::time_point receivedAt);
+void process_deletion_handler(ProcessListenerContext& ctx, ProcessInfo const& process);
+// an exec, the process stays what it was to the controller and the tree, and may now run a protected program.
+void process_replacement_handler(ProcessListenerContext& ctx, ProcessInfo process, std::chrono::steady_clock::time_point receivedAt);
+
+// brings the tree in line with a full scan and handles whatever started or exited unannounced, true when anything did.
+bool process_rescan_handler(ProcessListenerContext& ctx, ProcessTable const& processes);
+
+void process_suspension_handler(ProcessListenerContext& ctx);
+void process_resumption_handler(ProcessListenerContext& ctx, std::string_view password);
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "EventLog.hpp"
+#include "os/process/ProcessInfo.hpp"
+#include "os/process/ProcessTree.hpp"
+#include "os/process/ProcessUsageSampler.hpp"
+
+#include "imgui/imgui.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// case insensitive, the order every name column sorts in.
+std::weak_ordering compare_names(std::string_view lhs, std::string_view rhs);
+
+struct GroupUsage
+{
+    float cpuPercent = 0.0f;
+    std::uint64_t residentBytes = 0;
+    bool sampled = false;
+    bool hasRate = false;
+};
+
+// a row stands for every running process with the same name, so it shows their sum.
+GroupUsage group_usage(ProcessUsageSnapshot const& snapshot, std::vector<ProcessInfo> const& processes);
+
+struct ProcessTreeRow
+{
+    ProcessId pid;
+    int depth;
+};
+
+// lays the expanded part of the tree out in display order, siblings sorted by name.
+void flatten_process_tree(ProcessTree const& tree, std::unordered_set<ProcessId> const& expanded, std::vector<ProcessTreeRow>& rows, std::vector<ProcessTreeRow>& pending);
+
+// the clipper submits rows in a few separate ranges, the first one only to measure the row height.
+struct VisibleRanges
+{
+    std::array<std::pair<int, int>, 4> ranges {};
+    std::size_t count = 0;
+
+    void push(int begin, int end)
+    {
+        if (count == ranges.size()) return;
+        ranges[count] = { begin, end };
+        count += 1;
+    }
+
+    std::span<std::pair<int, int> const> view() const { return std::span(ranges).first(count); }
+};
+
+using ProcessGroup = std::pair<std::string const, std::vector<ProcessInfo>>;
+using ProtectedProgram = std::pair<std::string const, std::string>;
+
+struct ProcessTreeClicks
+{
+    ProcessId clicked = ProcessTree::ROOT;
+    ProcessId toggled = ProcessTree::ROOT;
+};
+
+//
+// The rows of the UI's tables, submitted through an ImGuiListClipper into a
+// table that is already set up. They run every frame, so clicks are handed
+// back instead of acted on and nothing in here touches the heap once ImGui's
+// buffers have grown to fit a frame (tests/FrameAllocationTest.cpp checks).
+//
+// The tree nodes keep the copy of their open state ImGui insists on in
+// nodeState rather than in the window, which reserve_node_state sizes for
+// every row whenever the tree is flattened again.
+//
+int process_table_rows(std::span<ProcessGroup const* const> rows, ProcessUsageSnapshot const& usage, int selectedRow, VisibleRanges& visible);
+ProcessTreeClicks process_tree_rows(ProcessTree const& tree, std::span<ProcessTreeRow const> rows, std::unordered_set<ProcessId> const& expanded, ProcessId selectedPid, ProcessUsageSnapshot const& usage, ImGuiStorage& nodeState, VisibleRanges& visible);
+void reserve_node_state(ImGuiStorage& nodeState, std::size_t rowCount);
+int protected_program_rows(std::span<ProtectedProgram const* const> rows, int selectedRow);
+void event_log_rows(EventLog const& log, std::chrono::steady_clock::time_point startedAt);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/event/EventSignal.hpp"
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+//
+// Single threaded reactor (WaitForMultipleObjects on Windows, epoll on
+// Linux). Event sources hand it a waitable handle and a callback, and
+// run_once() sleeps in the kernel until one of them is signaled, so an idle
+// loop costs nothing. On Windows waits are limited to MAXIMUM_WAIT_OBJECTS
+// handles, one of which is taken by the wake signal.
+//
+class EventLoop
+{
+public:
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(EventLoop const&) = delete;
+    EventLoop& operator=(EventLoop const&) = delete;
+
+    liberror::Result<void> watch(EventHandle handle, std::function<void()> callback);
+    void unwatch(EventHandle handle);
+
+    liberror::Result<void> add_timer(std::chrono::milliseconds interval, std::function<void()> callback);
+
+    // makes a blocked run_once() return, safe to call from any thread.
+    void wake() const { wakeSignal.raise(); }
+
+    liberror::Result<void> run_once();
+
+private:
+    struct Watch
+    {
+        EventHandle handle;
+        std::function<void()> callback;
+        bool timer;
+    };
+
+    EventSignal wakeSignal {};
+    std::vector<Watch> watches {};
+#ifndef _WIN32
+    int epoll = -1;
+#endif
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+using EventHandle = HANDLE;
+#else
+using EventHandle = int;
+#endif
+
+//
+// Auto-reset flag other threads can raise and an EventLoop can wait on (an
+// event object on Windows, an eventfd on Linux).
+//
+class EventSignal
+{
+public:
+    EventSignal();
+    ~EventSignal();
+
+    EventSignal(EventSignal const&) = delete;
+    EventSignal& operator=(EventSignal const&) = delete;
+
+    void raise() const;
+
+    // needed where the kernel doesn't clear the signal by itself on a wait.
+    void reset() const;
+
+    EventHandle handle() const { return event; }
+
+private:
+    EventHandle event;
+};
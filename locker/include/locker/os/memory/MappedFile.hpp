@@ -0,0 +1,47 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& that) noexcept;
+    MappedFile& operator=(MappedFile&& that) noexcept;
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    std::span<std::byte> bytes() const { return { static_cast<std::byte*>(view), size }; }
+
+    liberror::Result<void> resize(std::size_t newSize);
+    liberror::Result<void> flush() const;
+
+    friend liberror::Result<MappedFile> map_file(std::filesystem::path const& path, std::size_t minimumSize);
+
+private:
+    liberror::Result<void> map(std::size_t newSize);
+    void unmap();
+
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int file = -1;
+#endif
+    void* view = nullptr;
+    std::size_t size = 0;
+};
+
+liberror::Result<MappedFile> map_file(std::filesystem::path const& path, std::size_t minimumSize);
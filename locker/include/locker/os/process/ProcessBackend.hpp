@@ -0,0 +1,72 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/ProcessInfo.hpp"
+
+#include <concepts>
+#include <span>
+#include <vector>
+
+//
+// Where process events and full process listings come from. start() has the
+// source push every process creation and exit into the queue, from whatever
+// thread it likes, until stop() returns. usage() reads a single process's
+// resource usage and has to be safe to call from any thread.
+//
+template <class Source>
+concept ProcessSource = std::default_initializable<Source> && requires (Source& source, Source const& constSource, ProcessEventQueue& queue, ProcessId pid)
+{
+    { source.start(queue) } -> std::same_as<liberror::Result<void>>;
+    { source.stop() } -> std::same_as<void>;
+    { source.scan() } -> std::same_as<liberror::Result<ProcessTable>>;
+    { constSource.usage(pid) } -> std::same_as<liberror::Result<ProcessUsage>>;
+};
+
+//
+// What acts on processes. track() pins a process the moment it is discovered
+// by filling in its handle, and suspend() and resume() act on a whole batch
+// and report back per pid. suspend() only confirms a process once it has
+// actually stopped running, and times each process on its own.
+//
+template <class Controller>
+concept ProcessController = std::default_initializable<Controller> && requires (Controller& controller, ProcessInfo& process, ProcessInfo const& constProcess, ProcessId pid, std::span<ProcessInfo const> processes)
+{
+    { controller.track(process) } -> std::same_as<liberror::Result<void>>;
+    { controller.untrack(pid) } -> std::same_as<void>;
+    { controller.has_exited(constProcess) } -> std::same_as<bool>;
+    { controller.suspend(processes) } -> std::same_as<std::vector<ProcessOperationResult>>;
+    { controller.resume(processes) } -> std::same_as<std::vector<ProcessOperationResult>>;
+};
+
+//
+// The backend is picked at compile time, so the engine calls straight into
+// the concrete types. Configure with -DLOCKER_PROCESS_BACKEND=fake to run
+// against the in-memory simulation instead of the operating system.
+//
+#if defined(LOCKER_PROCESS_BACKEND_FAKE)
+
+#include "os/process/fake/FakeProcessBackend.hpp"
+using ProcessSourceBackend = FakeProcessSource;
+using ProcessControllerBackend = FakeProcessController;
+
+#elif defined(_WIN32)
+
+#include "os/process/windows/WindowsProcessBackend.hpp"
+using ProcessSourceBackend = WindowsProcessSource;
+using ProcessControllerBackend = WindowsProcessController;
+
+#elif defined(__linux__)
+
+#include "os/process/linux/LinuxProcessBackend.hpp"
+using ProcessSourceBackend = LinuxProcessSource;
+using ProcessControllerBackend = LinuxProcessController;
+
+#else
+#error "locker has no process backend for this platform"
+#endif
+
+static_assert(ProcessSource<ProcessSourceBackend>);
+static_assert(ProcessController<ProcessControllerBackend>);
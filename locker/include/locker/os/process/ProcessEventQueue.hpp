@@ -0,0 +1,118 @@
+#pragma once
+
+#include "os/event/EventSignal.hpp"
+#include "os/process/ProcessInfo.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+//
+// Fixed-size, so the queue can hold events in place without allocating. Names
+// longer than NAME_CAPACITY are cut short, which no real executable name
+// comes close to.
+//
+struct ProcessEvent
+{
+    // REPLACED is an exec, the process keeps its pid, parent and children but runs another program.
+    enum class Kind : std::uint8_t { CREATED, DELETED, REPLACED };
+
+    static constexpr std::size_t NAME_CAPACITY = 119;
+
+    ProcessEvent() = default;
+
+    ProcessEvent(Kind eventKind, ProcessId processId, std::string_view processName, ProcessId parentProcessId = 0)
+        : kind(eventKind)
+        , nameLength(static_cast<std::uint8_t>(std::min(processName.size(), NAME_CAPACITY)))
+        , pid(processId)
+        , parentPid(parentProcessId)
+    {
+        std::copy_n(processName.data(), nameLength, nameBuffer.data());
+    }
+
+    std::string_view name() const { return { nameBuffer.data(), nameLength }; }
+
+    Kind kind {};
+    std::uint8_t nameLength = 0;
+    ProcessId pid {};
+    // only creations and replacements carry the parent.
+    ProcessId parentPid {};
+
+    // stamped when the source builds the event, where enforcement latency starts counting.
+    std::chrono::steady_clock::time_point receivedAt = std::chrono::steady_clock::now();
+
+private:
+    std::array<char, NAME_CAPACITY> nameBuffer {};
+};
+
+struct ProcessEventQueueStatistics
+{
+    std::uint64_t pushed = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t backpressure = 0;
+    std::size_t highWatermark = 0;
+};
+
+//
+// Hand-off point between the event sources, which push from their own
+// threads, and the engine. It is a bounded lock-free ring for any number of
+// producers and a single consumer: producers claim a slot with a CAS on the
+// tail and publish it through the slot's sequence number, so neither side
+// ever takes a lock or allocates.
+//
+// A producer that finds the ring full backs off for a while (counted as
+// backpressure) and then drops the event (counted as dropped) rather than
+// stalling the source; the engine makes up for drops with a full rescan.
+// The first push after a drain raises event(), so the
+// engine can wait on it together with everything else in its EventLoop.
+//
+class ProcessEventQueue
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 16384;
+
+    explicit ProcessEventQueue(std::size_t capacity = DEFAULT_CAPACITY);
+
+    ProcessEventQueue(ProcessEventQueue const&) = delete;
+    ProcessEventQueue& operator=(ProcessEventQueue const&) = delete;
+
+    // false when the event had to be dropped because the ring stayed full.
+    bool push(ProcessEvent const& event);
+
+    // moves everything published so far into a buffer that is reused between drains; consumer only.
+    std::vector<ProcessEvent> const& drain();
+
+    ProcessEventQueueStatistics statistics() const;
+
+    EventHandle event() const { return signal.handle(); }
+
+private:
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        ProcessEvent event;
+    };
+
+    std::size_t const mask;
+    std::unique_ptr<Slot[]> slots;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail { 0 };
+    alignas(CACHE_LINE_SIZE) std::size_t head = 0;
+    std::vector<ProcessEvent> drained {};
+
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> pending { false };
+    std::atomic<std::uint64_t> pushed { 0 };
+    std::atomic<std::uint64_t> dropped { 0 };
+    std::atomic<std::uint64_t> backpressure { 0 };
+    std::atomic<std::size_t> highWatermark { 0 };
+
+    EventSignal signal {};
+};
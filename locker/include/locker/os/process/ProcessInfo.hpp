@@ -3,26 +3,30 @@
 #include <liberror/Result.hpp>
 #include <liberror/Try.hpp>
 
-#include <combaseapi.h>
-#include <comdef.h>
-#include <cwchar>
-#include <oleauto.h>
-#include <processthreadsapi.h>
-#include <wbemcli.h>
-#include <WbemIdl.h>
-#include <windows.h>
-#include <TlHelp32.h>
-#include <winerror.h>
-
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <unordered_map>
-#include <string_view>
 #include <vector>
 
+using ProcessId = std::uint32_t;
+
+//
+// Keeps a process pinned so its pid can't be handed to someone else while we
+// hold it (a process HANDLE on Windows, a pidfd on Linux). It is opaque to
+// everything but the ProcessController that created it.
+//
+using ProcessHandle = std::shared_ptr<void>;
+
 struct ProcessInfo
 {
     std::string name;
-    DWORD pid;
-    bool suspended;
+    ProcessId pid;
+    // 0 when the parent isn't known, or for the roots of the process tree.
+    ProcessId parentPid = 0;
+    bool suspended = false;
+    ProcessHandle handle {};
 
     bool operator==(ProcessInfo const& that) const
     {
@@ -30,8 +34,20 @@ struct ProcessInfo
     }
 };
 
-ProcessInfo get_started_process_info(IWbemClassObject* object);
-liberror::Result<DWORD> get_thread_id_from_pid(DWORD pid);
-liberror::Result<void> suspend_process_thread(ProcessInfo const& processInfo);
-liberror::Result<void> resume_process_thread(ProcessInfo const& processInfo);
-liberror::Result<std::unordered_map<std::string, std::vector<ProcessInfo>>> get_running_processes();
+struct ProcessOperationResult
+{
+    ProcessId pid;
+    liberror::Result<void> result;
+    // when this process's operation went out, and when the process was seen in its new state.
+    std::chrono::steady_clock::time_point issued {};
+    std::chrono::steady_clock::time_point confirmed {};
+};
+
+using ProcessTable = std::unordered_map<std::string, std::vector<ProcessInfo>>;
+
+// cumulative CPU time since the process started, and what it has resident right now.
+struct ProcessUsage
+{
+    std::chrono::nanoseconds cpuTime;
+    std::uint64_t residentBytes;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "os/process/ProcessInfo.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// what a reconcile found had started or exited without the events saying so, and who it linked under another parent.
+struct ProcessTreeChanges
+{
+    std::vector<ProcessInfo> started {};
+    std::vector<ProcessInfo> exited {};
+    std::vector<ProcessId> moved {};
+};
+
+//
+// Parent/child links between the running processes, updated one creation or
+// exit at a time. Every process hangs off its parent, or off ROOT when the
+// parent isn't known or has already exited. Children are kept unordered and
+// know their own position among their siblings, so both linking and
+// unlinking a process are O(1).
+//
+class ProcessTree
+{
+public:
+    static constexpr ProcessId ROOT = 0;
+
+    ProcessTree();
+
+    // a pid that is already in the tree is taken to have been reused and replaces the old process.
+    void insert(ProcessId pid, ProcessId parentPid, std::string const& name);
+
+    // the children of an erased process move up to ROOT, like orphans get reparented by the system.
+    void erase(ProcessId pid);
+
+    // for an exec, which changes what a process runs without touching its links.
+    void rename(ProcessId pid, std::string const& name);
+
+    // brings the tree in line with a full scan, only touching the processes that changed.
+    void reconcile(ProcessTable const& processes);
+    // the same, and tells what it had to add and remove; a reused pid counts as both.
+    void reconcile(ProcessTable const& processes, ProcessTreeChanges& changed);
+
+    bool contains(ProcessId pid) const { return pid != ROOT && nodes.contains(pid); }
+    std::span<ProcessId const> children(ProcessId pid) const;
+    std::string const& name(ProcessId pid) const;
+    std::size_t size() const { return nodes.size() - 1; }
+
+    // bumped by every change, so views over the tree know when to rebuild.
+    std::uint64_t generation() const { return changes; }
+
+    // the closest process from pid upwards, pid itself included, that fnAccept accepts.
+    std::optional<ProcessId> find_ancestor(ProcessId pid, auto&& fnAccept) const
+    {
+        // a reused pid can briefly make the links circular, so the walk is bounded by the tree's size.
+        for (auto hops = 0zu; pid != ROOT && hops < nodes.size(); hops += 1)
+        {
+            auto const node = nodes.find(pid);
+            if (node == nodes.end()) break;
+            if (fnAccept(pid, node->second.name)) return pid;
+            pid = node->second.parent;
+        }
+
+        return std::nullopt;
+    }
+
+private:
+    struct Node
+    {
+        // the parent it is linked under, and the parent the system reported, which may not be known yet.
+        ProcessId parent = ROOT;
+        ProcessId reportedParent = ROOT;
+        // outlived its parent; a scan still reports the parent's pid, which may belong to someone else by now.
+        bool orphaned = false;
+        std::uint32_t siblingIndex = 0;
+        std::vector<ProcessId> children {};
+        std::string name {};
+    };
+
+    void link(ProcessId pid, Node& node);
+    void unlink(Node& node);
+    bool is_descendant(ProcessId pid, ProcessId ancestor) const;
+
+    std::unordered_map<ProcessId, Node> nodes {};
+    std::vector<ProcessId> scratch {};
+    std::uint64_t changes = 0;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "os/process/ProcessBackend.hpp"
+#include "os/process/ProcessInfo.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct ProcessSample
+{
+    ProcessId pid {};
+    std::chrono::nanoseconds cpuTime {};
+    std::chrono::steady_clock::time_point sampledAt {};
+    // share of a single core over the last interval, so a busy multi-threaded process can go over 100.
+    float cpuPercent = 0.0f;
+    std::uint64_t residentBytes = 0;
+    bool hasRate = false;
+};
+
+//
+// Samples are kept in a flat array, one slot per process. A process holds on
+// to its slot for as long as it keeps being requested, which is what lets the
+// next round find the previous sample to compute the CPU rate from.
+//
+struct ProcessUsageSnapshot
+{
+    static constexpr auto NO_SLOT = ~std::uint32_t {};
+
+    std::vector<ProcessSample> samples {};
+    std::unordered_map<ProcessId, std::uint32_t> slots {};
+
+    ProcessSample const* find(ProcessId pid) const
+    {
+        auto const slot = slots.find(pid);
+        return slot == slots.end() ? nullptr : &samples[slot->second];
+    }
+};
+
+//
+// Reads the usage of the requested processes from a background thread every
+// interval. Neither request() nor copy_to() ever wait for the sampling
+// thread: when it happens to hold the lock the call just gives up and the
+// frontend tries again on its next frame.
+//
+class ProcessUsageSampler
+{
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_INTERVAL { 1000 };
+
+    explicit ProcessUsageSampler(ProcessSourceBackend const& processSource, std::chrono::milliseconds sampleInterval = DEFAULT_INTERVAL);
+
+    ProcessUsageSampler(ProcessUsageSampler const&) = delete;
+    ProcessUsageSampler& operator=(ProcessUsageSampler const&) = delete;
+
+    // the processes to sample from the next round on, anything left out loses its slot.
+    bool request(std::span<ProcessId const> pids);
+
+    // bumped every time a round is published.
+    std::uint64_t generation() const { return published.load(std::memory_order_acquire); }
+
+    bool copy_to(ProcessUsageSnapshot& snapshot);
+
+    void stop();
+
+private:
+    void run(std::stop_token stopToken);
+    void sample_round();
+
+    ProcessSourceBackend const& source;
+    std::chrono::milliseconds interval;
+
+    std::mutex requestMutex {};
+    std::vector<ProcessId> requested {};
+    std::vector<ProcessId> wanted {};
+
+    // only ever touched by the sampling thread.
+    ProcessUsageSnapshot current {};
+    std::vector<std::uint32_t> freeSlots {};
+    std::vector<std::uint64_t> slotRounds {};
+    std::uint64_t round = 0;
+
+    std::mutex snapshotMutex {};
+    ProcessUsageSnapshot latest {};
+    std::atomic<std::uint64_t> published {};
+
+    std::mutex sleepMutex {};
+    std::condition_variable_any sleeper {};
+    std::jthread sampler {};
+};
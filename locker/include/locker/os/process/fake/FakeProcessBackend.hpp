@@ -0,0 +1,103 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/ProcessInfo.hpp"
+#include "os/process/fake/FakeProcessGenerator.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//
+// In-memory stand-in for the operating system. Processes only exist inside
+// the world, which pushes the same events a real source would into whichever
+// queue the FakeProcessSource was started with.
+//
+// Every process gets a new incarnation when it is created, so a pid the
+// generator reuses is a different process as far as a tracked handle is
+// concerned, the same way a real handle keeps pointing at the process it was
+// opened on.
+//
+class FakeProcessWorld
+{
+public:
+    using Incarnation = std::uint64_t;
+
+    // applies a batch of generated actions under a single lock, and pushes their events once it's released.
+    void apply(std::span<FakeProcessAction const> actions, std::span<std::string const> names);
+
+    std::optional<Incarnation> incarnation_of(ProcessId pid) const;
+    bool is_alive(ProcessId pid, Incarnation incarnation) const;
+    bool is_suspended(ProcessId pid) const;
+    liberror::Result<ProcessUsage> usage(ProcessId pid) const;
+    // without an incarnation it acts on whichever process holds the pid right now.
+    liberror::Result<void> set_suspended(ProcessId pid, std::optional<Incarnation> incarnation, bool suspended);
+
+    void attach(ProcessEventQueue* queue);
+    ProcessTable snapshot() const;
+
+private:
+    struct FakeProcess
+    {
+        ProcessInfo info;
+        Incarnation incarnation;
+    };
+
+    mutable std::mutex mutex {};
+    std::chrono::steady_clock::time_point createdAt = std::chrono::steady_clock::now();
+    ProcessEventQueue* queue {};
+    Incarnation nextIncarnation = 1;
+    std::unordered_map<ProcessId, FakeProcess> processes {};
+};
+
+FakeProcessWorld& fake_process_world();
+
+//
+// Replays a FakeProcessWorkload into the world, paced by the timestamps of
+// the generated actions. The workload is read from LOCKER_FAKE_WORKLOAD (see
+// parse_fake_process_workload) when set.
+//
+class FakeProcessSource
+{
+public:
+    liberror::Result<void> start(ProcessEventQueue& queue);
+    void stop();
+    liberror::Result<ProcessTable> scan();
+    liberror::Result<ProcessUsage> usage(ProcessId pid) const;
+
+    // true once a workload with an event budget has been replayed in full.
+    bool finished() const { return replayed.load(std::memory_order_acquire); }
+
+private:
+    void replay(std::stop_token stopToken);
+
+    std::optional<FakeProcessGenerator> generator {};
+    std::atomic<bool> replayed { false };
+    std::mutex mutex {};
+    std::condition_variable_any sleeper {};
+    std::jthread player {};
+};
+
+class FakeProcessController
+{
+public:
+    liberror::Result<void> track(ProcessInfo& process);
+    void untrack(ProcessId pid) { processHandles.erase(pid); }
+    bool has_exited(ProcessInfo const& process) const;
+    std::vector<ProcessOperationResult> suspend(std::span<ProcessInfo const> processes);
+    std::vector<ProcessOperationResult> resume(std::span<ProcessInfo const> processes);
+
+private:
+    std::unordered_map<ProcessId, ProcessHandle> processHandles {};
+};
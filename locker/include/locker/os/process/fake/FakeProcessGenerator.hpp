@@ -0,0 +1,88 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/ProcessInfo.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//
+// Shape of the simulated process churn. Arrivals follow a Poisson process at
+// arrivalRate events per second (0 runs flat out), each creation has
+// burstProbability of turning into a fork storm of burstSize processes, and
+// exits are picked so the live count hovers around population. pids wrap
+// around at pidLimit, so lowering it makes pid reuse as frequent as wanted.
+// Every new process is forked from a random live one, a whole burst from the
+// same one, so the processes form a tree.
+//
+struct FakeProcessWorkload
+{
+    std::uint64_t seed = 1;
+    double arrivalRate = 1000.0;
+    std::size_t population = 1000;
+    std::size_t programs = 256;
+    double burstProbability = 0.0;
+    std::size_t burstSize = 64;
+    ProcessId pidLimit = 4194304;
+    std::uint64_t events = 0;
+};
+
+// parses "seed=7,rate=1000000,population=1000000,burst=0.01,pid_limit=32768"; omitted keys keep their default.
+liberror::Result<FakeProcessWorkload> parse_fake_process_workload(std::string_view text);
+
+struct FakeProcessAction
+{
+    ProcessEvent::Kind kind;
+    ProcessId pid;
+    ProcessId parentPid;
+    std::uint32_t program;
+    std::chrono::nanoseconds at;
+};
+
+//
+// Turns a workload into a stream of actions. The stream only depends on the
+// workload, never on timing, so the same seed replays the same storm.
+//
+class FakeProcessGenerator
+{
+public:
+    explicit FakeProcessGenerator(FakeProcessWorkload const& workload);
+
+    // the processes that are already running at time zero.
+    void populate(std::vector<FakeProcessAction>& actions);
+
+    // appends up to count actions, fewer once the workload's event budget runs out.
+    void generate(std::vector<FakeProcessAction>& actions, std::size_t count);
+
+    bool exhausted() const { return workload.events != 0 && generated >= workload.events; }
+    std::uint64_t generated_events() const { return generated; }
+    double arrival_rate() const { return workload.arrivalRate; }
+    std::vector<std::string> const& program_names() const { return names; }
+
+private:
+    void create(std::vector<FakeProcessAction>& actions, ProcessId parentPid);
+    ProcessId pick_parent();
+    void exit(std::vector<FakeProcessAction>& actions);
+    ProcessId allocate_pid();
+
+    static constexpr auto NOT_LIVE = std::numeric_limits<std::uint32_t>::max();
+
+    FakeProcessWorkload workload;
+    std::mt19937_64 random;
+    std::exponential_distribution<double> arrivals;
+    std::vector<std::string> names {};
+    std::vector<ProcessId> live {};
+    // slot of every live pid in live, indexed by pid; NOT_LIVE marks the free ones.
+    std::vector<std::uint32_t> liveIndex {};
+    ProcessId nextPid = 1;
+    std::chrono::nanoseconds now {};
+    std::uint64_t generated = 0;
+};
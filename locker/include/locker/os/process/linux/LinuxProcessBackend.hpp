@@ -0,0 +1,69 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/event/EventSignal.hpp"
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/ProcessInfo.hpp"
+#include "os/process/linux/ProcessTrace.hpp"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//
+// Events come from BPF programs on the fork, exec and exit tracepoints when
+// we are allowed to load them, otherwise from the netlink process connector,
+// which needs CAP_NET_ADMIN. An exec on a process already known from its
+// fork is a replacement rather than a second creation. Without either the
+// source falls back to diffing /proc on a short interval, which is also how
+// it catches up when the ring or the connector overflows. Listings come from
+// /proc/<pid>/comm, and parents from /proc/<pid>/stat.
+//
+class LinuxProcessSource
+{
+public:
+    liberror::Result<void> start(ProcessEventQueue& queue);
+    void stop();
+    liberror::Result<ProcessTable> scan();
+    liberror::Result<ProcessUsage> usage(ProcessId pid) const;
+
+private:
+    void listen_to_trace(ProcessEventQueue& queue, std::stop_token stopToken);
+    void listen_to_connector(ProcessEventQueue& queue, std::stop_token stopToken);
+    void poll_procfs(ProcessEventQueue& queue, std::stop_token stopToken);
+    void resync(ProcessEventQueue& queue);
+
+    // what the trace and the connector both see, turned into events.
+    void on_fork(ProcessEventQueue& queue, ProcessId pid, ProcessId parentPid, std::string name);
+    void on_exec(ProcessEventQueue& queue, ProcessId pid, std::string name);
+    void on_exit(ProcessEventQueue& queue, ProcessId pid);
+
+    std::optional<ProcessTraceSubscription> traceSubscription {};
+    int connector = -1;
+    EventSignal stopSignal {};
+    std::unordered_map<ProcessId, std::string> names {};
+    std::unordered_map<ProcessId, std::string> resyncNames {};
+    std::jthread listener {};
+};
+
+//
+// Processes are pinned with a pidfd and frozen as a whole with SIGSTOP, so
+// unlike on Windows there are no threads to enumerate.
+//
+class LinuxProcessController
+{
+public:
+    liberror::Result<void> track(ProcessInfo& process);
+    void untrack(ProcessId pid) { processHandles.erase(pid); }
+    bool has_exited(ProcessInfo const& process) const;
+    std::vector<ProcessOperationResult> suspend(std::span<ProcessInfo const> processes);
+    std::vector<ProcessOperationResult> resume(std::span<ProcessInfo const> processes);
+
+private:
+    std::unordered_map<ProcessId, ProcessHandle> processHandles {};
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/process/ProcessInfo.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// one fork, exec or exit, laid out the way the tracepoint programs write it into the ring.
+struct ProcessTraceRecord
+{
+    enum class Kind : std::uint32_t { FORK, EXEC, EXIT };
+
+    Kind kind;
+    ProcessId pid;
+    // only known for a fork, where the program runs in the parent.
+    ProcessId parentPid;
+    std::array<char, 16> name;
+};
+
+//
+// BPF programs on the task_newtask, sched_process_exec and sched_process_exit
+// tracepoints, loaded with the bpf() syscall directly so there is nothing to
+// build or link against. They run in the process the event is about, so the
+// pid, the parent of a fork and the name all come from the kernel at the time
+// of the event, with no racing to read /proc after it. Records go into a BPF
+// ring buffer, and whatever doesn't fit is counted so the caller knows when to
+// resync. Loading needs CAP_BPF and CAP_PERFMON, and tracefs mounted; callers
+// are expected to fall back to the process connector when it is refused.
+//
+struct ProcessTraceSubscription
+{
+    // the ring and the counter of records that didn't fit, both BPF maps mapped into our memory.
+    int ring = -1;
+    int lost = -1;
+    void* consumer = nullptr;
+    void* producer = nullptr;
+    void* lostCounter = nullptr;
+    std::uint64_t lostEvents = 0;
+    // the programs and the perf events attaching them, closing those detaches them.
+    std::vector<int> descriptors {};
+};
+
+liberror::Result<ProcessTraceSubscription> subscribe_to_process_trace_events();
+void unsubscribe_from_process_trace_events(ProcessTraceSubscription& subscription);
+
+// appends the records written since the last read and returns how many were dropped in the meantime.
+std::uint64_t read_process_trace_events(ProcessTraceSubscription& subscription, std::vector<ProcessTraceRecord>& records);
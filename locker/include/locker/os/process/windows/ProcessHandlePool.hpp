@@ -0,0 +1,27 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/process/ProcessInfo.hpp"
+
+#include <windows.h>
+
+#include <unordered_map>
+
+//
+// Owns one process handle per pid, opened once when the process is first
+// seen. While the handle is open Windows won't hand the pid to another
+// process, so anything holding a ProcessHandle can't end up acting on a
+// recycled pid. The pool lets go of its reference on release() and the handle
+// is closed as soon as the last ProcessInfo holding it goes away.
+//
+class ProcessHandlePool
+{
+public:
+    liberror::Result<ProcessHandle> acquire(ProcessId pid);
+    void release(ProcessId pid) { handles.erase(pid); }
+
+private:
+    std::unordered_map<ProcessId, ProcessHandle> handles {};
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/process/ProcessEventQueue.hpp"
+
+#include <windows.h>
+#include <evntrace.h>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+//
+// Real time ETW session on the Microsoft-Windows-Kernel-Process provider.
+// Start and stop events carry the pid and image name themselves, so nothing
+// has to be looked up after the fact, and they arrive without the WMI
+// "WITHIN 1" polling in between. Starting a kernel provider session needs
+// administrator rights; callers are expected to fall back to the WMI
+// subscriptions when it is refused.
+//
+struct ProcessTraceSubscription
+{
+    TRACEHANDLE session;
+    TRACEHANDLE trace;
+    std::vector<std::byte> properties;
+    std::jthread consumer;
+};
+
+liberror::Result<ProcessTraceSubscription> subscribe_to_process_trace_events(ProcessEventQueue& queue);
+void unsubscribe_from_process_trace_events(ProcessTraceSubscription& subscription);
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/ProcessInfo.hpp"
+
+#include <combaseapi.h>
+#include <comdef.h>
+#include <cwchar>
+#include <oleauto.h>
+#include <processthreadsapi.h>
+#include <string_view>
+#include <wbemcli.h>
+#include <WbemIdl.h>
+#include <windows.h>
+#include <TlHelp32.h>
+#include <winerror.h>
+
+ProcessInfo get_started_process_info(IWbemClassObject* object);
+
+liberror::Result<void> initialize_com();
+liberror::Result<void> connect_to_wmi(IWbemLocator*& locator, IWbemServices*& service);
+liberror::Result<void> set_wmi_proxy_blanket(IWbemLocator* locator, IWbemServices* service);
+//
+// Receives WMI notifications on a WMI owned thread and forwards them to a
+// ProcessEventQueue, so nobody has to poll the notification queries.
+//
+class ProcessEventSink : public IWbemObjectSink
+{
+public:
+    ProcessEventSink(ProcessEventQueue& eventQueue, ProcessEvent::Kind eventKind);
+    virtual ~ProcessEventSink() = default;
+
+    ULONG STDMETHODCALLTYPE AddRef() override;
+    ULONG STDMETHODCALLTYPE Release() override;
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override;
+    HRESULT STDMETHODCALLTYPE Indicate(LONG objectCount, IWbemClassObject __RPC_FAR* __RPC_FAR* objects) override;
+    HRESULT STDMETHODCALLTYPE SetStatus(LONG flags, HRESULT result, BSTR parameter, IWbemClassObject __RPC_FAR* object) override;
+
+private:
+    LONG references = 1;
+    ProcessEventQueue& queue;
+    ProcessEvent::Kind kind;
+};
+
+struct ProcessEventSubscription
+{
+    IUnsecuredApartment* apartment;
+    ProcessEventSink* sink;
+    IWbemObjectSink* stub;
+};
+
+liberror::Result<ProcessEventSubscription> subscribe_to_process_creation_events(IWbemLocator* locator, IWbemServices* service, ProcessEventQueue& queue);
+liberror::Result<ProcessEventSubscription> subscribe_to_process_deletion_events(IWbemLocator* locator, IWbemServices* service, ProcessEventQueue& queue);
+void unsubscribe_from_process_events(IWbemServices* service, ProcessEventSubscription& subscription);
+
+
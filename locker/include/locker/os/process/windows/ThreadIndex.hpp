@@ -0,0 +1,36 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include <windows.h>
+
+#include <span>
+#include <vector>
+
+struct ThreadEntry
+{
+    DWORD pid;
+    DWORD tid;
+};
+
+//
+// Maps processes to their threads. The whole table is built from a single
+// Toolhelp snapshot walk into a buffer that is reused between refreshes, and
+// it is kept until invalidate() is called. The controller does that at the
+// start of every pass over a suspend or resume batch, since threads come and
+// go without any process event, so a pass costs one snapshot instead of one
+// per process.
+//
+class ThreadIndex
+{
+public:
+    liberror::Result<std::span<ThreadEntry const>> threads_of(DWORD pid);
+    void invalidate() { stale = true; }
+
+private:
+    liberror::Result<void> refresh();
+
+    std::vector<ThreadEntry> entries {};
+    bool stale = true;
+};
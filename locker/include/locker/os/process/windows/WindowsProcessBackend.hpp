@@ -0,0 +1,54 @@
+#pragma once
+
+#include <liberror/Result.hpp>
+#include <liberror/Try.hpp>
+
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/ProcessInfo.hpp"
+#include "os/process/windows/ProcessHandlePool.hpp"
+#include "os/process/windows/ProcessTrace.hpp"
+#include "os/process/windows/ProcessWatcher.hpp"
+#include "os/process/windows/ThreadIndex.hpp"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+//
+// Events come from the kernel ETW trace when we are allowed to start one and
+// from the WMI notification queries otherwise. Listings come from a Toolhelp
+// process snapshot.
+//
+class WindowsProcessSource
+{
+public:
+    liberror::Result<void> start(ProcessEventQueue& queue);
+    void stop();
+    liberror::Result<ProcessTable> scan();
+    liberror::Result<ProcessUsage> usage(ProcessId pid) const;
+
+private:
+    IWbemLocator* locator = nullptr;
+    IWbemServices* service = nullptr;
+    std::optional<ProcessTraceSubscription> traceSubscription {};
+    ProcessEventSubscription creationSubscription {};
+    ProcessEventSubscription deletionSubscription {};
+};
+
+//
+// Processes are pinned with a process handle and frozen thread by thread,
+// with the threads looked up in a shared ThreadIndex.
+//
+class WindowsProcessController
+{
+public:
+    liberror::Result<void> track(ProcessInfo& process);
+    void untrack(ProcessId pid) { processHandles.release(pid); }
+    bool has_exited(ProcessInfo const& process) const;
+    std::vector<ProcessOperationResult> suspend(std::span<ProcessInfo const> processes);
+    std::vector<ProcessOperationResult> resume(std::span<ProcessInfo const> processes);
+
+private:
+    ThreadIndex threadIndex {};
+    ProcessHandlePool processHandles {};
+};
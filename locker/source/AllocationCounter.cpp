@@ -0,0 +1,85 @@
+#include "AllocationCounter.hpp"
+
+#ifdef LOCKER_ALLOCATION_COUNTING
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+static thread_local std::uint64_t allocations = 0;
+
+std::uint64_t allocation_count()
+{
+    return allocations;
+}
+
+void* counted_malloc(std::size_t size, void*)
+{
+    allocations += 1;
+    return std::malloc(size);
+}
+
+void counted_free(void* pointer, void*)
+{
+    std::free(pointer);
+}
+
+void report_scope_allocations(std::uint64_t count, std::source_location location)
+{
+    spdlog::warn("{} allocations inside the NoAllocationScope at {}:{}", count, location.file_name(), location.line());
+}
+
+//
+// Only the single object forms are replaced, the array and nothrow forms of
+// the standard library forward to them.
+//
+void* operator new(std::size_t size)
+{
+    allocations += 1;
+
+    if (auto* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocations += 1;
+
+    auto const bytes = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    auto* pointer = _aligned_malloc(size == 0 ? 1 : size, bytes);
+#else
+    auto* pointer = std::aligned_alloc(bytes, (std::max<std::size_t>(size, 1) + bytes - 1) / bytes * bytes);
+#endif
+
+    if (pointer) return pointer;
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    ::operator delete(pointer, alignment);
+}
+
+#endif
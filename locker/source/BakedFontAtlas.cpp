@@ -0,0 +1,86 @@
+#include "BakedFontAtlas.hpp"
+
+#include "imgui/imgui.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+using namespace liberror;
+
+Result<void> load_baked_font_atlas(ImFontAtlas& atlas, BakedFontAtlas const& baked)
+{
+    auto const pixelCount = static_cast<std::size_t>(baked.width) * static_cast<std::size_t>(baked.height);
+
+    if (baked.glyphs.empty() || baked.pixels.size() % 2 != 0 || baked.lines.size() != std::size(atlas.TexUvLines) * 4)
+    {
+        return make_error("the baked font atlas is malformed");
+    }
+
+    auto* pixels = static_cast<unsigned int*>(IM_ALLOC(pixelCount * sizeof(unsigned int)));
+    auto decoded = 0zu;
+
+    for (auto run = 0zu; run < baked.pixels.size() && decoded < pixelCount; run += 2)
+    {
+        auto const count = std::min<std::size_t>(baked.pixels[run], pixelCount - decoded);
+        auto const alpha = static_cast<unsigned int>(baked.pixels[run + 1]);
+        // white with the glyph coverage as alpha, which is what GetTexDataAsRGBA32 would have expanded it into.
+        std::fill_n(pixels + decoded, count, (alpha << IM_COL32_A_SHIFT) | 0x00FFFFFFu);
+        decoded += count;
+    }
+
+    if (decoded != pixelCount)
+    {
+        IM_FREE(pixels);
+        return make_error("the baked font atlas holds {} of its {} pixels", decoded, pixelCount);
+    }
+
+    atlas.Clear();
+
+    auto* font = IM_NEW(ImFont);
+    font->ContainerAtlas = &atlas;
+    font->FontSize = baked.fontSize;
+    font->Ascent = baked.ascent;
+    font->Descent = baked.descent;
+
+    font->Glyphs.resize(static_cast<int>(baked.glyphs.size()));
+    for (auto index = 0; index < font->Glyphs.Size; index += 1)
+    {
+        auto& glyph = font->Glyphs[index];
+        auto const& bakedGlyph = baked.glyphs[static_cast<std::size_t>(index)];
+        glyph.Codepoint = bakedGlyph.codepoint & IM_UNICODE_CODEPOINT_MAX;
+        glyph.Colored = bakedGlyph.colored;
+        glyph.Visible = bakedGlyph.visible;
+        glyph.AdvanceX = bakedGlyph.advanceX;
+        glyph.X0 = bakedGlyph.x0;
+        glyph.Y0 = bakedGlyph.y0;
+        glyph.X1 = bakedGlyph.x1;
+        glyph.Y1 = bakedGlyph.y1;
+        glyph.U0 = bakedGlyph.u0;
+        glyph.V0 = bakedGlyph.v0;
+        glyph.U1 = bakedGlyph.u1;
+        glyph.V1 = bakedGlyph.v1;
+    }
+
+    // the lookup tables, fallback and ellipsis are derived from the glyphs the same way Build() derives them.
+    font->BuildLookupTable();
+    atlas.Fonts.push_back(font);
+
+    atlas.TexWidth = baked.width;
+    atlas.TexHeight = baked.height;
+    atlas.TexUvScale = { 1.0f / static_cast<float>(baked.width), 1.0f / static_cast<float>(baked.height) };
+    atlas.TexUvWhitePixel = { baked.whitePixel[0], baked.whitePixel[1] };
+    for (auto line = 0zu; line < std::size(atlas.TexUvLines); line += 1)
+    {
+        auto const uvs = baked.lines.subspan(line * 4, 4);
+        atlas.TexUvLines[line] = { uvs[0], uvs[1], uvs[2], uvs[3] };
+    }
+
+    // the software mouse cursors are custom rects only Build() knows the place of.
+    atlas.Flags |= ImFontAtlasFlags_NoMouseCursors;
+    atlas.TexPixelsRGBA32 = pixels;
+    atlas.TexPixelsUseColors = false;
+    atlas.TexReady = true;
+
+    return {};
+}
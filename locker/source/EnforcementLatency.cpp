@@ -0,0 +1,27 @@
+#include "EnforcementLatency.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <string_view>
+
+static void log_enforcement_leg(std::string_view name, LatencyHistogram const& histogram)
+{
+    spdlog::info(
+        "enforcement {}: {} samples, mean {:.0f}ns p50 {}ns p99 {}ns p999 {}ns max {}ns",
+        name,
+        histogram.count(),
+        histogram.mean(),
+        histogram.percentile(50.0),
+        histogram.percentile(99.0),
+        histogram.percentile(99.9),
+        histogram.max()
+    );
+}
+
+void log_enforcement_latency(EnforcementLatency const& latency)
+{
+    log_enforcement_leg("delivery", latency.delivery);
+    log_enforcement_leg("dispatch", latency.dispatch);
+    log_enforcement_leg("freeze", latency.freeze);
+    log_enforcement_leg("total", latency.total);
+}
@@ -0,0 +1,48 @@
+#include "EventLog.hpp"
+
+#include <algorithm>
+
+EventLog::EventLog(std::size_t logCapacity)
+    : capacity(std::max<std::size_t>(logCapacity, 1))
+{
+}
+
+void EventLog::push(EventLogKind kind, ProcessId pid, std::string_view name)
+{
+    pushed += 1;
+
+    // the ring only grows to its capacity, from then on the oldest entry makes room.
+    if (entries.size() < capacity)
+    {
+        entries.push_back({ std::chrono::steady_clock::now(), kind, pid, std::string(name) });
+        return;
+    }
+
+    auto& entry = entries[oldest];
+    entry.at = std::chrono::steady_clock::now();
+    entry.kind = kind;
+    entry.pid = pid;
+    entry.name.assign(name);
+    oldest = (oldest + 1) % capacity;
+}
+
+void EventLog::clear()
+{
+    entries.clear();
+    oldest = 0;
+}
+
+char const* to_string(EventLogKind kind)
+{
+    switch (kind)
+    {
+    case EventLogKind::STARTED: return "started";
+    case EventLogKind::EXITED: return "exited";
+    case EventLogKind::SUSPENDED: return "suspended";
+    case EventLogKind::SUSPEND_FAILED: return "suspend failed";
+    case EventLogKind::RESUMED: return "resumed";
+    case EventLogKind::RESUME_FAILED: return "resume failed";
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,121 @@
+#include "FrameProfiler.hpp"
+
+#include "AllocationCounter.hpp"
+
+#include "imgui/imgui.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+static constexpr std::array<char const*, FrameProfiler::STAGE_COUNT> STAGE_NAMES {
+    "wait", "new frame", "engine lock", "build ui", "search", "render", "submit", "swap", "events", "rescan"
+};
+
+static constexpr float NANOSECONDS_PER_MILLISECOND = 1e6f;
+
+FrameProfiler::FrameProfiler()
+    : frameAllocations(allocation_count())
+    , gpuTimers(GLAD_GL_VERSION_3_3 != 0)
+{
+    if (gpuTimers) glGenQueries(static_cast<GLsizei>(gpuQueries.size()), gpuQueries.data());
+}
+
+void FrameProfiler::shutdown()
+{
+    if (gpuTimers) glDeleteQueries(static_cast<GLsizei>(gpuQueries.size()), gpuQueries.data());
+    gpuTimers = false;
+}
+
+void FrameProfiler::begin_gpu_timer()
+{
+    if (!gpuTimers) return;
+
+    // the slot about to be reused was issued GPU_QUERIES frames ago, which is normally long done.
+    if (gpuQueryIssued[gpuQuery])
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(gpuQueries[gpuQuery], GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (available)
+        {
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(gpuQueries[gpuQuery], GL_QUERY_RESULT, &elapsed);
+            lastGpuTime = static_cast<float>(elapsed) / NANOSECONDS_PER_MILLISECOND;
+        }
+    }
+
+    glBeginQuery(GL_TIME_ELAPSED, gpuQueries[gpuQuery]);
+}
+
+void FrameProfiler::end_gpu_timer()
+{
+    if (!gpuTimers) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    gpuQueryIssued[gpuQuery] = true;
+    gpuQuery = (gpuQuery + 1) % gpuQueries.size();
+}
+
+void FrameProfiler::end_frame()
+{
+    auto const now = std::chrono::steady_clock::now();
+    auto const allocations = allocation_count();
+
+    for (auto stage = 0zu; stage < STAGE_COUNT; stage += 1)
+    {
+        push(stageHistory[stage], static_cast<float>(pending[stage].exchange(0, std::memory_order_relaxed)) / NANOSECONDS_PER_MILLISECOND);
+    }
+
+    push(frameHistory, std::chrono::duration<float, std::milli>(now - frameStart).count());
+    push(gpuHistory, lastGpuTime);
+    push(allocationHistory, static_cast<float>(allocations - frameAllocations));
+
+    frameStart = now;
+    frameAllocations = allocations;
+    cursor = (cursor + 1) % HISTORY;
+}
+
+void FrameProfiler::draw()
+{
+    if (ImGui::IsKeyPressed(ImGuiKey_F12, false)) visible = !visible;
+    if (!visible) return;
+
+    constexpr ImVec2 GRAPH_SIZE { 260, 32 };
+
+    // newest sample sits right before the cursor.
+    auto const latest = (cursor + HISTORY - 1) % HISTORY;
+    auto const offset = static_cast<int>(cursor);
+    std::array<char, 64> overlay {};
+
+    auto const fnPlot = [&] (char const* label, std::array<float, HISTORY> const& history, char const* unit) {
+        auto const average = std::accumulate(history.begin(), history.end(), 0.f) / static_cast<float>(HISTORY);
+        auto const peak = std::ranges::max(history);
+        std::snprintf(overlay.data(), overlay.size(), "%.2f%s (avg %.2f, max %.2f)", static_cast<double>(history[latest]), unit, static_cast<double>(average), static_cast<double>(peak));
+        ImGui::PlotLines(label, history.data(), static_cast<int>(HISTORY), offset, overlay.data(), 0.f, std::max(peak, 1e-3f), GRAPH_SIZE);
+    };
+
+    ImGui::SetNextWindowBgAlpha(0.85f);
+    ImGui::SetNextWindowPos(ImGui::GetMainViewport()->WorkSize, ImGuiCond_FirstUseEver, { 1.f, 1.f });
+
+    if (ImGui::Begin("Profiler", &visible, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing))
+    {
+        fnPlot("frame", frameHistory, "ms");
+
+        for (auto stage = 0zu; stage < STAGE_COUNT; stage += 1)
+        {
+            fnPlot(STAGE_NAMES[stage], stageHistory[stage], "ms");
+        }
+
+        if (gpuTimers) fnPlot("gpu render", gpuHistory, "ms");
+        else ImGui::TextDisabled("gpu render: timer queries unavailable");
+
+#ifdef LOCKER_ALLOCATION_COUNTING
+        fnPlot("allocations", allocationHistory, "");
+#else
+        ImGui::TextDisabled("allocations: not counted in this build");
+#endif
+    }
+
+    ImGui::End();
+}
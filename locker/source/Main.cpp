@@ -1,20 +1,41 @@
 #include <functional>
 #define NOMINMAX
 
-#include "os/process/ProcessWatcher.hpp"
+#include "os/event/EventLoop.hpp"
+#include "os/process/ProcessBackend.hpp"
+#include "os/process/ProcessEventQueue.hpp"
 #include "os/process/ProcessInfo.hpp"
+#include "os/process/ProcessTree.hpp"
+#include "os/process/ProcessUsageSampler.hpp"
+#include "AllocationCounter.hpp"
+#include "BakedFontAtlas.hpp"
+#include "EnforcementLatency.hpp"
+#include "EventLog.hpp"
+#include "FrameProfiler.hpp"
 #include "Memoizer.hpp"
+#include "ProcessListener.hpp"
+#include "TableRows.hpp"
 
 #include <spdlog/spdlog.h>
-#include <fmt/format.h>
 
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <iterator>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <ranges>
+#include <span>
 #include <algorithm>
+#include <array>
 
 #include "glad/glad.h"
-#include "gl/gl.h"
 #include <GLFW/glfw3.h>
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw.h"
@@ -22,177 +43,371 @@
 
 using namespace liberror;
 
+// matches MAX_PATH, which is what these buffers were sized by back when locker only ran on Windows.
+static constexpr auto MAX_NAME_LENGTH = 260;
+
+#ifdef LOCKER_MEMOIZER_STATISTICS
+static MemoizerStatistics editDistanceStatistics {};
+#endif
+
 size_t calculate_edit_distance(std::string_view a, std::string_view b)
 {
-    Memoizer<size_t(std::string_view, std::string_view)> memoizer {};
-
-    memoizer = [&memoizer] (std::string_view a, std::string_view b) {
-        if (a.empty()) return b.size();
-        if (b.empty()) return a.size();
-        auto const tailA = a.substr(1);
-        auto const tailB = b.substr(1);
-        if (a.front() == b.front()) return memoizer(tailA, tailB);
+    thread_local MemoizerArena arena {};
+    arena.reset();
+
+    // the subproblems are suffixes of a and b, so they are keyed by where those suffixes start.
+    auto const columns = b.size() + 1;
+
+    auto memoizer = make_dense_memoizer<size_t(size_t, size_t)>([a, b] (auto& self, size_t i, size_t j) -> size_t {
+        if (i == a.size()) return b.size() - j;
+        if (j == b.size()) return a.size() - i;
+        if (a[i] == b[j]) return self(i + 1, j + 1);
         return 1 + std::ranges::min({
-            memoizer(tailA, b),
-            memoizer(a, tailB),
-            memoizer(tailA, tailB)
+            self(i + 1, j),
+            self(i, j + 1),
+            self(i + 1, j + 1)
         });
-    };
+    }, [columns] (size_t i, size_t j) { return i * columns + j; }, (a.size() + 1) * columns, arena.resource());
+
+    auto const distance = memoizer(0, 0);
 
-    return memoizer(a, b);
+#ifdef LOCKER_MEMOIZER_STATISTICS
+    editDistanceStatistics += memoizer.statistics();
+#endif
+
+    return distance;
 }
 
-struct ProcessListenerContext
-{
-    IEnumWbemClassObject* processCreationListener;
-    IEnumWbemClassObject* processDeletionListener;
-    std::unordered_map<std::string, std::string>& protectedPrograms;
-    std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>>& runningProcesses;
-    std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>>& suspensionQueue;
-    std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>>& suspendedProcesses;
-    std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>>& resumedProcesses;
-};
+enum class TableColumn : ImGuiID { NAME, PID, CPU, MEMORY, PASSWORD };
 
-void process_creation_handler(ProcessListenerContext& ctx)
+//
+// Sorts a table's materialized rows by its current sort specs. fnCompareColumn
+// orders two rows by a single TableColumn; ties fall through to the next spec.
+//
+template <class Row>
+void sort_table_rows(std::vector<Row const*>& rows, ImGuiTableSortSpecs const& sortSpecs, auto&& fnCompareColumn)
 {
-    IWbemClassObject* object = nullptr;
-    ULONG result = 0;
-    ctx.processCreationListener->Next(WBEM_NO_WAIT, 1, &object, &result);
-    if (result == 0) return;
-
-    auto process = get_started_process_info(object);
+    std::ranges::stable_sort(rows, [&] (Row const* lhs, Row const* rhs) {
+        for (auto const& spec : std::span(sortSpecs.Specs, static_cast<std::size_t>(sortSpecs.SpecsCount)))
+        {
+            auto const order = fnCompareColumn(static_cast<TableColumn>(spec.ColumnUserID), *lhs, *rhs);
+            if (order == 0) continue;
+            return spec.SortDirection == ImGuiSortDirection_Ascending ? order < 0 : order > 0;
+        }
 
-    if (ctx.protectedPrograms.contains(process.name) && !ctx.resumedProcesses.contains(process.name))
-    {
-        ctx.suspensionQueue[process.name].push_back(process);
-    }
+        return false;
+    });
 }
 
-void process_deletion_handler(ProcessListenerContext& ctx)
+// whether two scans show the same thing, the same names with the same processes running under each.
+bool same_processes(ProcessTable const& lhs, ProcessTable const& rhs)
 {
-    IWbemClassObject* object = nullptr;
-    ULONG result = 0;
-    ctx.processDeletionListener->Next(WBEM_NO_WAIT, 1, &object, &result);
-    if (result == 0) return;
+    if (lhs.size() != rhs.size()) return false;
 
-    auto process = get_started_process_info(object);
-
-    if (!ctx.runningProcesses.contains(process.name) && ctx.resumedProcesses.contains(process.name))
-    {
-        ctx.resumedProcesses.erase(process.name);
-    }
+    return std::ranges::all_of(lhs, [&rhs] (auto const& entry) {
+        auto const other = rhs.find(entry.first);
+        return other != rhs.end() && std::ranges::equal(entry.second, other->second, [] (ProcessInfo const& a, ProcessInfo const& b) {
+            return a.pid == b.pid && a.parentPid == b.parentPid;
+        });
+    });
 }
 
-void process_suspension_handler(ProcessListenerContext& ctx)
+// LOCKER_SAMPLE_INTERVAL_MS overrides how often the CPU and memory columns are sampled.
+std::chrono::milliseconds usage_sample_interval()
 {
-    for (auto& process : ctx.suspensionQueue)
+    auto const* value = std::getenv("LOCKER_SAMPLE_INTERVAL_MS");
+    if (value == nullptr) return ProcessUsageSampler::DEFAULT_INTERVAL;
+
+    std::string_view const text { value };
+    auto milliseconds = 0u;
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), milliseconds);
+    if (error != std::errc {} || end != text.data() + text.size() || milliseconds == 0)
     {
-        for (auto& processThread : process.second)
-        {
-            ctx.suspendedProcesses[process.first].push_back(processThread);
-            MUST(suspend_process_thread(processThread));
-        }
+        spdlog::warn("Ignoring LOCKER_SAMPLE_INTERVAL_MS={}, it has to be a positive number of milliseconds", text);
+        return ProcessUsageSampler::DEFAULT_INTERVAL;
     }
 
-    std::ranges::for_each(ctx.suspendedProcesses, [&] (auto&& suspendedProcess) {
-        ctx.suspensionQueue.erase(suspendedProcess.first);
-    });
+    return std::chrono::milliseconds { milliseconds };
 }
 
-void process_resumption_handler(ProcessListenerContext& ctx, std::string_view password)
+// where a panel goes in the default layout, as fractions of the work area: x, y, width and height.
+static constexpr ImVec4 PROCESSES_PLACEMENT { 0.0f, 0.0f, 0.6f, 0.7f };
+static constexpr ImVec4 PROGRAMS_PLACEMENT { 0.6f, 0.0f, 0.4f, 0.4f };
+static constexpr ImVec4 METRICS_PLACEMENT { 0.6f, 0.4f, 0.4f, 0.3f };
+static constexpr ImVec4 EVENT_LOG_PLACEMENT { 0.0f, 0.7f, 1.0f, 0.3f };
+
+struct PanelLayout
 {
-    for (auto& process : ctx.suspendedProcesses)
-    {
-        if (ctx.protectedPrograms.at(process.first) != password) continue;
+    // the viewport's work area only leaves room for the menu bar from the frame after it first shows up, so its height is taken as it's drawn.
+    float menuBarHeight = 0.0f;
+    bool reset = false;
+};
 
-        for (auto& processThread : process.second)
-        {
-            ctx.resumedProcesses[process.first].push_back(processThread);
-            MUST(resume_process_thread(processThread));
-        }
-    }
+// begins a panel's window, put where the default layout has it on the first run or when the layout is reset.
+bool begin_panel(char const* name, bool& open, ImVec4 placement, PanelLayout const& layout)
+{
+    auto const* viewport = ImGui::GetMainViewport();
+    auto const condition = layout.reset ? ImGuiCond_Always : ImGuiCond_FirstUseEver;
+    ImVec2 const workPos { viewport->Pos.x, viewport->Pos.y + layout.menuBarHeight };
+    ImVec2 const workSize { viewport->Size.x, viewport->Size.y - layout.menuBarHeight };
 
-    std::ranges::for_each(ctx.resumedProcesses, [&] (auto&& resumedProcess) {
-        ctx.suspendedProcesses.erase(resumedProcess.first);
-    });
+    ImGui::SetNextWindowPos({ workPos.x + workSize.x * placement.x, workPos.y + workSize.y * placement.y }, condition);
+    ImGui::SetNextWindowSize({ workSize.x * placement.z, workSize.y * placement.w }, condition);
+
+    return ImGui::Begin(name, &open);
 }
 
 int main()
 {
+    auto const startedAt = std::chrono::steady_clock::now();
+
     glfwInit();
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
-    glfwWindowHint(GLFW_RESIZABLE, false);
+    glfwWindowHint(GLFW_RESIZABLE, true);
 
-    auto window = glfwCreateWindow(825, 600, "locker", nullptr, nullptr);
+    auto window = glfwCreateWindow(1280, 800, "locker", nullptr, nullptr);
+    glfwSetWindowSizeLimits(window, 640, 400, GLFW_DONT_CARE, GLFW_DONT_CARE);
     glfwMakeContextCurrent(window);
     glfwSwapInterval(1);
 
     gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
 
     IMGUI_CHECKVERSION();
+#ifdef LOCKER_ALLOCATION_COUNTING
+    // ImGui allocates with malloc, so the NoAllocationScopes around the rows would miss it without these.
+    ImGui::SetAllocatorFunctions(counted_malloc, counted_free);
+#endif
     ImGui::CreateContext();
     ImGui::StyleColorsDark();
 
+#ifdef LOCKER_BAKED_FONT_ATLAS
+    if (auto loaded = load_baked_font_atlas(*ImGui::GetIO().Fonts, BAKED_FONT_ATLAS); !loaded)
+    {
+        spdlog::warn("Building the font atlas at runtime: {}", loaded.error().message());
+    }
+#endif
+
+    // GLFW doesn't say what woke it, so input is noted on its way to ImGui, whose callbacks chain to these.
+    static auto inputReceived = false;
+    glfwSetCursorPosCallback(window, [] (GLFWwindow*, double, double) { inputReceived = true; });
+    glfwSetMouseButtonCallback(window, [] (GLFWwindow*, int, int, int) { inputReceived = true; });
+    glfwSetScrollCallback(window, [] (GLFWwindow*, double, double) { inputReceived = true; });
+    glfwSetKeyCallback(window, [] (GLFWwindow*, int, int, int, int) { inputReceived = true; });
+    glfwSetCharCallback(window, [] (GLFWwindow*, unsigned int) { inputReceived = true; });
+
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init("#version 130");
 
     int width, height;
     glfwGetFramebufferSize(window, &width, &height);
 
-    MUST(initialize_com());
-
-    IWbemLocator* locator = nullptr;
-    IWbemServices* service = nullptr;
-
-    MUST(connect_to_wmi(locator, service));
-    MUST(set_wmi_proxy_blanket(locator, service));
-    auto processCreationListener = MUST(get_process_creation_event_listener(locator, service));
-    auto processDeletionListener = MUST(get_process_deletion_event_listener(locator, service));
+    FrameProfiler profiler {};
 
     std::unordered_map<std::string, std::string> protectedProcesses {};
-    std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>> suspensionQueue {};
+    std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>> runningProcesses {};
+    std::uint64_t runningProcessesGeneration = 0;
+    std::uint64_t protectedProcessesGeneration = 0;
+    ProcessTree processTree {};
+    std::unordered_set<ProcessId> unannouncedProcesses {};
+    SuspensionQueue suspensionQueue {};
     std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>> suspendedProcesses {};
     std::unordered_map<std::basic_string<char>, std::vector<ProcessInfo>> resumedProcesses {};
+    ProcessControllerBackend processController {};
+    std::unordered_map<ProcessId, EnforcementTrace> enforcementTraces {};
+    EnforcementLatency enforcementLatency {};
+    EventLog eventLog {};
+
+    ProcessListenerContext processListenerContext {
+        protectedProcesses,
+        runningProcesses,
+        processTree,
+        unannouncedProcesses,
+        suspensionQueue,
+        suspendedProcesses,
+        resumedProcesses,
+        processController,
+        enforcementTraces,
+        enforcementLatency,
+        eventLog
+    };
+
+    //
+    // The engine runs on its own thread and sleeps in the EventLoop until the
+    // process source delivers an event or the rescan timer fires. Everything reachable
+    // from processListenerContext is shared with the UI thread and only touched
+    // with engineMutex held.
+    //
+    std::mutex engineMutex {};
+    ProcessEventQueue processEvents {};
+    EventLoop eventLoop {};
+
+    ProcessSourceBackend processSource {};
+
+    MUST(processSource.start(processEvents));
+    runningProcesses = MUST(processSource.scan());
+    processTree.reconcile(runningProcesses);
+
+    // the UI asks for the processes it shows every frame and picks up new samples whenever they're published.
+    ProcessUsageSampler usageSampler { processSource, usage_sample_interval() };
+    ProcessUsageSnapshot usageSnapshot {};
+    std::uint64_t usageGeneration = 0;
+    std::vector<ProcessId> sampledPids {};
+
+    // events the queue had to drop are only made up for by a full scan, which handles whatever they would have.
+    auto const fnRescan = [&] {
+        auto const rescanTimer = profiler.time(ProfilerStage::RESCAN);
+        auto processes = MUST(processSource.scan());
+        std::scoped_lock lock { engineMutex };
+
+        auto changed = false;
+
+        if (!same_processes(processes, runningProcesses))
+        {
+            runningProcesses = std::move(processes);
+            runningProcessesGeneration += 1;
+            changed = true;
+        }
+
+        changed = process_rescan_handler(processListenerContext, runningProcesses) || changed;
+
+        // retries don't wait for the next process event, a failed suspend gets another go every rescan.
+        auto const enforcing = !suspensionQueue.empty();
+        process_suspension_handler(processListenerContext);
+
+        // a rescan that found nothing new leaves the UI asleep.
+        if (changed || enforcing) glfwPostEmptyEvent();
+    };
+
+    std::uint64_t droppedEvents = 0;
+
+    MUST(eventLoop.watch(processEvents.event(), [&] {
+        {
+            auto const eventsTimer = profiler.time(ProfilerStage::EVENTS);
+            std::scoped_lock lock { engineMutex };
+
+            for (auto const& event : processEvents.drain())
+            {
+                switch (event.kind)
+                {
+                case ProcessEvent::Kind::CREATED: process_creation_handler(processListenerContext, ProcessInfo { std::string(event.name()), event.pid, event.parentPid }, event.receivedAt); break;
+                case ProcessEvent::Kind::DELETED: process_deletion_handler(processListenerContext, ProcessInfo { std::string(event.name()), event.pid }); break;
+                case ProcessEvent::Kind::REPLACED: process_replacement_handler(processListenerContext, ProcessInfo { std::string(event.name()), event.pid, event.parentPid }, event.receivedAt); break;
+                }
+            }
+
+            // only enforcement changes what the UI shows, everything else can wait for the next idle redraw.
+            auto const enforcing = !suspensionQueue.empty();
+            process_suspension_handler(processListenerContext);
+            if (enforcing) glfwPostEmptyEvent();
+        }
+
+        // a dropped creation could be a protected program, which can't be left running until the next rescan.
+        if (auto const dropped = processEvents.statistics().dropped; dropped != droppedEvents)
+        {
+            spdlog::warn("The process event queue dropped {} events, rescanning", dropped - droppedEvents);
+            droppedEvents = dropped;
+            fnRescan();
+        }
+    }));
+
+    MUST(eventLoop.add_timer(std::chrono::seconds(1), fnRescan));
+
+    std::jthread engine([&eventLoop] (std::stop_token stopToken) {
+        while (!stopToken.stop_requested())
+        {
+            MUST(eventLoop.run_once());
+        }
+    });
+
+    //
+    // The UI only redraws when woken by input or by the engine posting an empty
+    // event after a state change, plus a slow idle tick so the statistics keep
+    // moving. Input is followed by a few frames back to back, which is what ImGui
+    // needs to settle hover and popup state, while any other wake draws just one.
+    //
+    constexpr auto IDLE_REDRAW_INTERVAL = 1.0;
+    constexpr auto SETTLE_FRAMES = 2;
+    auto settleFrames = 0;
+    auto firstFrame = true;
 
     while (!glfwWindowShouldClose(window))
     {
-        glfwPollEvents();
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-
-        auto runningProcesses = MUST(get_running_processes());
-
-        ProcessListenerContext processListenerContext {
-            processCreationListener,
-            processDeletionListener,
-            protectedProcesses,
-            runningProcesses,
-            suspensionQueue,
-            suspendedProcesses,
-            resumedProcesses
-        };
-
-        process_creation_handler(processListenerContext);
-        process_deletion_handler(processListenerContext);
-        process_suspension_handler(processListenerContext);
+        {
+            auto const waitTimer = profiler.time(ProfilerStage::WAIT);
+
+            inputReceived = false;
 
-        ImGui::SetNextWindowPos({});
-        ImGui::SetNextWindowSize({ static_cast<float>(width), static_cast<float>(height) });
-        ImGui::Begin("Locker", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+            if (settleFrames > 0)
+            {
+                glfwPollEvents();
+                settleFrames -= 1;
+            }
+            else
+            {
+                glfwWaitEventsTimeout(IDLE_REDRAW_INTERVAL);
+            }
+
+            if (inputReceived) settleFrames = SETTLE_FRAMES;
+        }
+
+        {
+            auto const newFrameTimer = profiler.time(ProfilerStage::NEW_FRAME);
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+        }
+
+        std::unique_lock engineLock { engineMutex, std::defer_lock };
+
+        {
+            auto const lockTimer = profiler.time(ProfilerStage::ENGINE_LOCK);
+            engineLock.lock();
+        }
+
+        auto const buildStart = std::chrono::steady_clock::now();
+
+        // every panel is a window of its own, laid out over the work area on the first run and left wherever the user moves it after that.
+        static auto showProcesses = true;
+        static auto showPrograms = true;
+        static auto showEventLog = true;
+        static auto showMetrics = true;
+        PanelLayout panelLayout {};
+
+        if (ImGui::BeginMainMenuBar())
+        {
+            panelLayout.menuBarHeight = ImGui::GetWindowHeight();
+
+            if (ImGui::BeginMenu("View"))
+            {
+                ImGui::MenuItem("Processes", nullptr, &showProcesses);
+                ImGui::MenuItem("Protected Programs", nullptr, &showPrograms);
+                ImGui::MenuItem("Event Log", nullptr, &showEventLog);
+                ImGui::MenuItem("Metrics", nullptr, &showMetrics);
+                ImGui::Separator();
+                panelLayout.reset = ImGui::MenuItem("Reset Layout");
+                ImGui::EndMenu();
+            }
+            ImGui::EndMainMenuBar();
+        }
+
+        if (panelLayout.reset)
+        {
+            showProcesses = showPrograms = showEventLog = showMetrics = true;
+        }
 
+        // not part of any panel, locking a program has to ask for its password even with all of them closed.
         if (!suspendedProcesses.empty())
         {
             ImGui::OpenPopup("unlock_program_popup");
         }
 
-        if (ImGui::BeginPopup("unlock_program_popup"))
+        if (!suspendedProcesses.empty() && ImGui::BeginPopup("unlock_program_popup"))
         {
             static char password[256] = {};
-            auto& processInfo = (processListenerContext.suspendedProcesses | std::views::values).front();
-            ImGui::Text("Type the password for %s", processInfo.front().name.data());
+            auto const& program = (suspendedProcesses | std::views::keys).front();
+            ImGui::Text("Type the password for %s", program.data());
             ImGui::Separator();
             ImGui::Text("Password");
             ImGui::InputText("##password", password, sizeof(password));
@@ -204,54 +419,156 @@ int main()
             ImGui::EndPopup();
         }
 
-        ImGui::BeginGroup();
-            static char searchProcessName[MAX_PATH] = {};
-            static std::string previousSearchProcessName {};
-            ImGui::Text("Search Process");
-            ImGui::SetNextItemWidth(400);
-            ImGui::InputText("##search_process", searchProcessName, sizeof(searchProcessName));
-
-            auto searchProcessNameFixed = std::string_view(searchProcessName) | std::views::transform(tolower) | std::ranges::to<std::string>();
-            auto filteredProcesses = std::views::filter(runningProcesses, [&searchProcessNameFixed] (std::pair<std::string, std::vector<ProcessInfo>> const& lhs) {
-                if (searchProcessNameFixed.empty()) return true;
-                auto lhsFixed = lhs.first | std::views::transform(tolower) | std::ranges::to<std::string>();
-                lhsFixed = lhsFixed.substr(0, lhsFixed.find("."));
-                auto distanceLhs = static_cast<float>(calculate_edit_distance(searchProcessNameFixed, lhsFixed));
-                auto sizeLhs = static_cast<float>(std::ranges::max(lhsFixed.size(), searchProcessNameFixed.size()));
-                return (sizeLhs - distanceLhs) / sizeLhs * 100.f > 50;
-            });
-
-            ImGui::Text("Running Processes");
-            if (ImGui::BeginTable("##running_processes", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY, ImVec2(400, 200)))
+        sampledPids.clear();
+
+        // a panel that is closed, collapsed or scrolled off screen skips building its contents altogether.
+        if (showProcesses)
+        {
+            if (begin_panel("Processes", showProcesses, PROCESSES_PLACEMENT, panelLayout))
             {
-                ImGui::TableSetupColumn("Process Name");
-                ImGui::TableSetupColumn("Process Id");
-                ImGui::TableHeadersRow();
+                static char searchProcessName[MAX_NAME_LENGTH] = {};
+                static std::string previousSearchProcessName {};
+                ImGui::Text("Search Process");
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                ImGui::InputText("##search_process", searchProcessName, sizeof(searchProcessName));
+
+                // the filtered rows only change with the search text or a rescan, so they're materialized once and not every frame.
+                static std::vector<decltype(runningProcesses)::value_type const*> processRows {};
+                static auto processRowsGeneration = ~std::uint64_t { 0 };
+                static auto processRowsSorted = false;
+                static auto processRowsSortedByUsage = false;
+
+                if (processRowsGeneration != runningProcessesGeneration || previousSearchProcessName != searchProcessName)
+                {
+                    auto const searchTimer = profiler.time(ProfilerStage::SEARCH);
+                    processRowsGeneration = runningProcessesGeneration;
+                    previousSearchProcessName = searchProcessName;
+
+                    auto searchProcessNameFixed = previousSearchProcessName | std::views::transform(tolower) | std::ranges::to<std::string>();
+                    auto filteredProcesses = std::views::filter(runningProcesses, [&searchProcessNameFixed] (std::pair<std::string, std::vector<ProcessInfo>> const& lhs) {
+                        if (searchProcessNameFixed.empty()) return true;
+                        auto lhsFixed = lhs.first | std::views::transform(tolower) | std::ranges::to<std::string>();
+                        lhsFixed = lhsFixed.substr(0, lhsFixed.find("."));
+                        auto distanceLhs = static_cast<float>(calculate_edit_distance(searchProcessNameFixed, lhsFixed));
+                        auto sizeLhs = static_cast<float>(std::ranges::max(lhsFixed.size(), searchProcessNameFixed.size()));
+                        return (sizeLhs - distanceLhs) / sizeLhs * 100.f > 50;
+                    });
+
+                    processRows.clear();
+                    std::ranges::transform(filteredProcesses, std::back_inserter(processRows), [] (auto const& process) { return &process; });
+                    processRowsSorted = false;
+                }
+
+                // copy_to() gives up instead of waiting when the sampler is publishing, the next frame tries again.
+                if (auto const generation = usageSampler.generation(); generation != usageGeneration && usageSampler.copy_to(usageSnapshot))
+                {
+                    usageGeneration = generation;
+                    if (processRowsSortedByUsage) processRowsSorted = false;
+                }
+
+                VisibleRanges visibleRanges {};
 
-                static auto selectedRow = -1;
                 static std::string selectedProcessName {};
+                auto protectClicked = false;
+
+                static auto showProcessTree = false;
+                ImGui::Text("Running Processes");
+                ImGui::SameLine();
+                ImGui::Checkbox("Tree", &showProcessTree);
 
-                for (auto const& [rowIndex, process] : filteredProcesses | std::views::enumerate)
+                if (!showProcessTree && ImGui::BeginTable("##running_processes", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable))
                 {
-                    bool selected = static_cast<int>(rowIndex) == selectedRow;
+                    ImGui::TableSetupColumn("Process Name", ImGuiTableColumnFlags_DefaultSort, 0.f, static_cast<ImGuiID>(TableColumn::NAME));
+                    ImGui::TableSetupColumn("Process Id", ImGuiTableColumnFlags_None, 0.f, static_cast<ImGuiID>(TableColumn::PID));
+                    ImGui::TableSetupColumn("CPU", ImGuiTableColumnFlags_PreferSortDescending, 0.f, static_cast<ImGuiID>(TableColumn::CPU));
+                    ImGui::TableSetupColumn("Memory", ImGuiTableColumnFlags_PreferSortDescending, 0.f, static_cast<ImGuiID>(TableColumn::MEMORY));
+                    ImGui::TableHeadersRow();
+
+                    // the rows stay sorted until they're rebuilt or the user picks another order.
+                    if (auto* sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs && (sortSpecs->SpecsDirty || !processRowsSorted))
+                    {
+                        sort_table_rows(processRows, *sortSpecs, [&] (TableColumn column, auto const& lhs, auto const& rhs) {
+                            switch (column)
+                            {
+                            case TableColumn::PID: return std::weak_ordering(lhs.second.front().pid <=> rhs.second.front().pid);
+                            case TableColumn::CPU: return std::weak_order(group_usage(usageSnapshot, lhs.second).cpuPercent, group_usage(usageSnapshot, rhs.second).cpuPercent);
+                            case TableColumn::MEMORY: return std::weak_ordering(group_usage(usageSnapshot, lhs.second).residentBytes <=> group_usage(usageSnapshot, rhs.second).residentBytes);
+                            default: return compare_names(lhs.first, rhs.first);
+                            }
+                        });
+
+                        // an order by usage goes stale with every new sample, any other only with the rows.
+                        processRowsSortedByUsage = std::ranges::any_of(std::span(sortSpecs->Specs, static_cast<std::size_t>(sortSpecs->SpecsCount)), [] (auto const& spec) {
+                            auto const column = static_cast<TableColumn>(spec.ColumnUserID);
+                            return column == TableColumn::CPU || column == TableColumn::MEMORY;
+                        });
+
+                        sortSpecs->SpecsDirty = false;
+                        processRowsSorted = true;
+                    }
 
-                    ImGui::TableNextRow();
+                    static auto selectedRow = -1;
 
-                    ImGui::TableNextColumn();
-                    ImGui::Text("%s", process.first.data());
-                    ImGui::TableNextColumn();
-                    ImGui::Text("%lu", process.second.front().pid);
+                    // rows are built every frame, so clicks are only acted on once they're all submitted.
+                    auto const clickedRow = process_table_rows(processRows, usageSnapshot, selectedRow, visibleRanges);
 
-                    ImGui::TableSetColumnIndex(0);
-                    if (ImGui::Selectable(fmt::format("##{}", rowIndex).data(), selected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick))
+                    if (clickedRow != -1)
                     {
-                        selectedRow = static_cast<int>(rowIndex);
-                        selectedProcessName = process.first;
-                        if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
-                        {
-                            ImGui::OpenPopup("protect_program_popup");
-                        }
+                        selectedRow = clickedRow;
+                        selectedProcessName = processRows[static_cast<std::size_t>(clickedRow)]->first;
+                        protectClicked = ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left);
                     }
+
+                    ImGui::EndTable();
+                }
+
+                // the tree is flattened into on-screen order once, and only again when it or what is expanded changes.
+                static std::vector<ProcessTreeRow> treeRows {};
+                static std::vector<ProcessTreeRow> treePending {};
+                static std::unordered_set<ProcessId> expandedPids {};
+                static ImGuiStorage treeNodeState {};
+                static auto treeRowsGeneration = ~std::uint64_t { 0 };
+                static auto treeRowsExpanded = false;
+
+                if (showProcessTree && (treeRowsGeneration != processTree.generation() || !treeRowsExpanded))
+                {
+                    treeRowsGeneration = processTree.generation();
+                    treeRowsExpanded = true;
+                    flatten_process_tree(processTree, expandedPids, treeRows, treePending);
+                    reserve_node_state(treeNodeState, treeRows.size());
+                }
+
+                if (showProcessTree && ImGui::BeginTable("##process_tree", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY))
+                {
+                    ImGui::TableSetupColumn("Process Name");
+                    ImGui::TableSetupColumn("Process Id");
+                    ImGui::TableSetupColumn("CPU");
+                    ImGui::TableSetupColumn("Memory");
+                    ImGui::TableHeadersRow();
+
+                    static auto selectedPid = ProcessTree::ROOT;
+
+                    auto const [clickedPid, toggledPid] = process_tree_rows(processTree, treeRows, expandedPids, selectedPid, usageSnapshot, treeNodeState, visibleRanges);
+
+                    if (toggledPid != ProcessTree::ROOT)
+                    {
+                        if (!expandedPids.erase(toggledPid)) expandedPids.insert(toggledPid);
+                        treeRowsExpanded = false;
+                    }
+
+                    if (clickedPid != ProcessTree::ROOT)
+                    {
+                        selectedPid = clickedPid;
+                        selectedProcessName = processTree.name(clickedPid);
+                        protectClicked = ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left);
+                    }
+
+                    ImGui::EndTable();
+                }
+
+                if (protectClicked)
+                {
+                    ImGui::OpenPopup("protect_program_popup");
                 }
 
                 if (ImGui::BeginPopup("protect_program_popup"))
@@ -262,65 +579,208 @@ int main()
                     if (ImGui::Button("Protect"))
                     {
                         protectedProcesses.insert({ selectedProcessName, password });
+                        protectedProcessesGeneration += 1;
                         ImGui::CloseCurrentPopup();
                     }
                     ImGui::EndPopup();
                 }
 
-                ImGui::EndTable();
+                // an order by usage is only right when every row has a sample, not just the ones on screen.
+                if (!showProcessTree && processRowsSortedByUsage)
+                {
+                    for (auto const* process : processRows)
+                    {
+                        std::ranges::transform(process->second, std::back_inserter(sampledPids), &ProcessInfo::pid);
+                    }
+                }
+                else
+                {
+                    for (auto const& [begin, end] : visibleRanges.view())
+                    {
+                        auto const fnVisible = [&] (auto const& rows) { return std::span(rows).subspan(static_cast<std::size_t>(begin), static_cast<std::size_t>(end - begin)); };
+
+                        if (showProcessTree)
+                        {
+                            std::ranges::transform(fnVisible(treeRows), std::back_inserter(sampledPids), &ProcessTreeRow::pid);
+                            continue;
+                        }
+
+                        for (auto const* process : fnVisible(processRows))
+                        {
+                            std::ranges::transform(process->second, std::back_inserter(sampledPids), &ProcessInfo::pid);
+                        }
+                    }
+                }
             }
-        ImGui::EndGroup();
+            ImGui::End();
+        }
 
-        ImGui::SameLine();
+        // only what is on screen gets sampled, or every row while they're ordered by usage, plus whatever runs under a protected name.
+        for (auto const& name : protectedProcesses | std::views::keys)
+        {
+            if (auto const running = runningProcesses.find(name); running != runningProcesses.end())
+            {
+                std::ranges::transform(running->second, std::back_inserter(sampledPids), &ProcessInfo::pid);
+            }
+        }
+        usageSampler.request(sampledPids);
 
-        ImGui::BeginGroup();
-            static char searchProgramName[MAX_PATH] = {};
-            ImGui::Text("Search Program");
-            ImGui::SetNextItemWidth(400);
-            ImGui::InputText("##search_program", searchProgramName, sizeof(searchProcessName));
-            ImGui::Text("Protected Programs");
-            if (ImGui::BeginTable("##protected_programs", 2, ImGuiTableFlags_Resizable | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY, ImVec2(400, 200)))
+        if (showPrograms)
+        {
+            if (begin_panel("Protected Programs", showPrograms, PROGRAMS_PLACEMENT, panelLayout))
             {
-                ImGui::TableSetupColumn("Name");
-                ImGui::TableSetupColumn("Password");
-                ImGui::TableHeadersRow();
+                static char searchProgramName[MAX_NAME_LENGTH] = {};
+                ImGui::Text("Search Program");
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                ImGui::InputText("##search_program", searchProgramName, sizeof(searchProgramName));
+                if (ImGui::BeginTable("##protected_programs", 2, ImGuiTableFlags_Resizable | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable))
+                {
+                    ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_DefaultSort, 0.f, static_cast<ImGuiID>(TableColumn::NAME));
+                    ImGui::TableSetupColumn("Password", ImGuiTableColumnFlags_NoSort, 0.f, static_cast<ImGuiID>(TableColumn::PASSWORD));
+                    ImGui::TableHeadersRow();
+
+                    static auto selectedRow = -1;
+                    static std::vector<decltype(protectedProcesses)::value_type const*> programRows {};
+                    static auto programRowsGeneration = ~std::uint64_t { 0 };
+                    static auto programRowsSorted = false;
+
+                    if (programRowsGeneration != protectedProcessesGeneration)
+                    {
+                        programRowsGeneration = protectedProcessesGeneration;
+                        programRows.clear();
+                        std::ranges::transform(protectedProcesses, std::back_inserter(programRows), [] (auto const& program) { return &program; });
+                        programRowsSorted = false;
+                    }
+
+                    if (auto* sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs && (sortSpecs->SpecsDirty || !programRowsSorted))
+                    {
+                        sort_table_rows(programRows, *sortSpecs, [] (TableColumn, auto const& lhs, auto const& rhs) {
+                            return compare_names(lhs.first, rhs.first);
+                        });
+
+                        sortSpecs->SpecsDirty = false;
+                        programRowsSorted = true;
+                    }
+
+                    if (auto const clickedRow = protected_program_rows(programRows, selectedRow); clickedRow != -1)
+                    {
+                        selectedRow = clickedRow;
+                    }
 
-                static auto selectedRow = -1;
+                    ImGui::EndTable();
+                }
+            }
+            ImGui::End();
+        }
 
-                for (auto const& [rowIndex, value] : std::views::enumerate(protectedProcesses))
+        if (showEventLog)
+        {
+            if (begin_panel("Event Log", showEventLog, EVENT_LOG_PLACEMENT, panelLayout))
+            {
+                if (ImGui::Button("Clear"))
                 {
-                    auto const& program = value;
-                    bool selected = static_cast<int>(rowIndex) == selectedRow;
+                    eventLog.clear();
+                }
+                ImGui::SameLine();
+                ImGui::Text("%zu events, %llu since startup", eventLog.size(), static_cast<unsigned long long>(eventLog.total()));
 
-                    ImGui::TableNextRow();
+                if (ImGui::BeginTable("##event_log", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY))
+                {
+                    ImGui::TableSetupScrollFreeze(0, 1);
+                    ImGui::TableSetupColumn("Time");
+                    ImGui::TableSetupColumn("Event");
+                    ImGui::TableSetupColumn("Process Id");
+                    ImGui::TableSetupColumn("Process Name");
+                    ImGui::TableHeadersRow();
 
-                    ImGui::TableNextColumn();
-                    ImGui::Text("%s", program.first.data());
-                    ImGui::TableNextColumn();
-                    ImGui::Text("%s", program.second.data());
+                    event_log_rows(eventLog, startedAt);
 
-                    ImGui::TableSetColumnIndex(0);
-                    if (ImGui::Selectable(fmt::format("##{}", rowIndex).data(), selected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick))
+                    // follows the newest events for as long as the view is scrolled all the way down.
+                    if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
                     {
-                        selectedRow = static_cast<int>(rowIndex);
+                        ImGui::SetScrollHereY(1.0f);
                     }
+
+                    ImGui::EndTable();
                 }
+            }
+            ImGui::End();
+        }
 
-                ImGui::EndTable();
+        if (showMetrics)
+        {
+            if (begin_panel("Metrics", showMetrics, METRICS_PLACEMENT, panelLayout))
+            {
+                auto suspendedCount = 0zu;
+                for (auto const& processes : suspendedProcesses | std::views::values) suspendedCount += processes.size();
+                ImGui::Text("Processes: %zu running under %zu names, %zu suspended", processTree.size(), runningProcesses.size(), suspendedCount);
+
+                auto const fnMicroseconds = [] (std::uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; };
+                ImGui::Text(
+                    "Enforcement latency: p50 %.1fus, p99 %.1fus, p999 %.1fus over %llu enforcements",
+                    fnMicroseconds(enforcementLatency.total.percentile(50.0)),
+                    fnMicroseconds(enforcementLatency.total.percentile(99.0)),
+                    fnMicroseconds(enforcementLatency.total.percentile(99.9)),
+                    static_cast<unsigned long long>(enforcementLatency.total.count())
+                );
+
+                auto const queueStatistics = processEvents.statistics();
+                ImGui::Text(
+                    "Event queue: %llu pushed, %llu dropped, %llu backpressured, high watermark %zu",
+                    static_cast<unsigned long long>(queueStatistics.pushed),
+                    static_cast<unsigned long long>(queueStatistics.dropped),
+                    static_cast<unsigned long long>(queueStatistics.backpressure),
+                    queueStatistics.highWatermark
+                );
             }
-        ImGui::EndGroup();
+            ImGui::End();
+        }
+        engineLock.unlock();
+
+        profiler.draw();
+        profiler.add(ProfilerStage::BUILD_UI, std::chrono::steady_clock::now() - buildStart);
 
-        ImGui::End();
+        {
+            auto const renderTimer = profiler.time(ProfilerStage::RENDER);
+            ImGui::Render();
+            glfwGetFramebufferSize(window, &width, &height);
+            glViewport(0, 0, width, height);
+            glClearColor(0.f, 0.f, 0.f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            profiler.begin_gpu_timer();
+            {
+                auto const submitTimer = profiler.time(ProfilerStage::SUBMIT);
+                ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            }
+            profiler.end_gpu_timer();
+        }
 
-        ImGui::Render();
-        glfwGetFramebufferSize(window, &width, &height);
-        glViewport(0, 0, width, height);
-        glClearColor(0.f, 0.f, 0.f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        glfwSwapBuffers(window);
+        {
+            auto const swapTimer = profiler.time(ProfilerStage::SWAP);
+            glfwSwapBuffers(window);
+        }
+
+        if (firstFrame)
+        {
+            firstFrame = false;
+            auto const startup = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startedAt);
+            spdlog::info("first frame presented {:.1f} ms after startup", startup.count());
+        }
+
+        profiler.end_frame();
     }
 
+    // the engine posts to glfw, so it has to be gone before glfw is.
+    engine.request_stop();
+    eventLoop.wake();
+    engine.join();
+
+#ifdef LOCKER_MEMOIZER_STATISTICS
+    log_memoizer_statistics("calculate_edit_distance", editDistanceStatistics);
+#endif
+
+    profiler.shutdown();
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -328,9 +788,17 @@ int main()
     glfwDestroyWindow(window);
     glfwTerminate();
 
-    service->Release();
-    locator->Release();
-    processCreationListener->Release();
-    processDeletionListener->Release();
-    CoUninitialize();
+    usageSampler.stop();
+    processSource.stop();
+
+    log_enforcement_latency(enforcementLatency);
+
+    auto const queueStatistics = processEvents.statistics();
+    spdlog::info(
+        "process events: {} pushed, {} dropped, {} backpressured, high watermark {}",
+        queueStatistics.pushed,
+        queueStatistics.dropped,
+        queueStatistics.backpressure,
+        queueStatistics.highWatermark
+    );
 }
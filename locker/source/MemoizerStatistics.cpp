@@ -0,0 +1,27 @@
+#include "MemoizerStatistics.hpp"
+
+#include <spdlog/spdlog.h>
+
+void log_memoizer_statistics(std::string_view name, MemoizerStatistics const& statistics)
+{
+    spdlog::info(
+        "memoizer {}: {} hits, {} misses ({:.1f}% hit ratio), {:.2f} average probe length, {} bytes held",
+        name,
+        statistics.hits,
+        statistics.misses,
+        statistics.hit_ratio() * 100.0,
+        statistics.average_probe_length(),
+        statistics.bytes
+    );
+
+    spdlog::info(
+        "memoizer {}: {} calls, latency mean {:.0f}ns p50 {}ns p99 {}ns p999 {}ns max {}ns",
+        name,
+        statistics.latency.count(),
+        statistics.latency.mean(),
+        statistics.latency.percentile(50.0),
+        statistics.latency.percentile(99.0),
+        statistics.latency.percentile(99.9),
+        statistics.latency.max()
+    );
+}
@@ -0,0 +1,233 @@
+#include "ProcessListener.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <ranges>
+
+// queued or frozen already, so a process seen twice isn't suspended twice; a frozen one that has exited since doesn't count.
+static bool is_enforced(ProcessListenerContext const& ctx, ProcessId pid)
+{
+    return ctx.suspensionQueue.contains(pid) || std::ranges::any_of(ctx.suspendedProcesses | std::views::values, [&] (auto const& processes) {
+        return std::ranges::any_of(processes, [&] (ProcessInfo const& process) { return process.pid == pid && !ctx.controller.has_exited(process); });
+    });
+}
+
+static void lock_if_protected(ProcessListenerContext& ctx, ProcessInfo process, std::chrono::steady_clock::time_point receivedAt)
+{
+    // whatever a locked program starts is locked along with it, so a launcher can't hand its work off to a child.
+    auto const lockedBy = ctx.processTree.find_ancestor(process.pid, [&] (ProcessId, std::string const& name) {
+        return ctx.protectedPrograms.contains(name) && !ctx.resumedProcesses.contains(name);
+    });
+
+    if (!lockedBy || is_enforced(ctx, process.pid)) return;
+
+    if (auto tracked = ctx.controller.track(process); !tracked)
+    {
+        spdlog::warn("Tracking {} ({}) by pid only: {}", process.name, process.pid, tracked.error().message());
+    }
+
+    ctx.enforcementTraces.insert_or_assign(process.pid, EnforcementTrace { .received = receivedAt, .queued = std::chrono::steady_clock::now() });
+    ctx.suspensionQueue.push(std::move(process), ctx.processTree.name(*lockedBy));
+}
+
+// a process linked under its parent only now may have been started by a protected program, and so may whatever it started since.
+static void lock_subtree_if_protected(ProcessListenerContext& ctx, ProcessId pid, std::chrono::steady_clock::time_point receivedAt)
+{
+    thread_local std::vector<ProcessId> pending {};
+    pending.assign(1, pid);
+
+    while (!pending.empty())
+    {
+        auto const next = pending.back();
+        pending.pop_back();
+
+        lock_if_protected(ctx, ProcessInfo { ctx.processTree.name(next), next }, receivedAt);
+
+        auto const children = ctx.processTree.children(next);
+        pending.insert(pending.end(), children.begin(), children.end());
+    }
+}
+
+// everything but the tree, which the caller has already taken the process out of.
+static void forget_process(ProcessListenerContext& ctx, ProcessInfo const& process)
+{
+    ctx.controller.untrack(process.pid);
+    ctx.unannouncedProcesses.erase(process.pid);
+    ctx.suspensionQueue.erase(process.pid);
+    ctx.enforcementTraces.erase(process.pid);
+    ctx.eventLog.push(EventLogKind::EXITED, process.pid, process.name);
+
+    if (!ctx.runningProcesses.contains(process.name) && ctx.resumedProcesses.contains(process.name))
+    {
+        ctx.resumedProcesses.erase(process.name);
+    }
+
+    // a suspended process can still be killed from outside; its handle says whether this exit was its, and one tracked by pid only has to take it as its own.
+    for (auto& processes : ctx.suspendedProcesses | std::views::values)
+    {
+        std::erase_if(processes, [&] (auto const& processInfo) {
+            return processInfo.pid == process.pid && (processInfo.handle == nullptr || ctx.controller.has_exited(processInfo));
+        });
+    }
+
+    std::erase_if(ctx.suspendedProcesses, [] (auto const& suspendedProcess) { return suspendedProcess.second.empty(); });
+}
+
+void process_creation_handler(ProcessListenerContext& ctx, ProcessInfo process, std::chrono::steady_clock::time_point receivedAt)
+{
+    if (ctx.processTree.contains(process.pid))
+    {
+        // a rescan got to it first, unless the pid was reused by the same program since; then the old handle has exited and it's locked anew.
+        if (ctx.unannouncedProcesses.erase(process.pid) && ctx.processTree.name(process.pid) == process.name)
+        {
+            lock_if_protected(ctx, std::move(process), receivedAt);
+            return;
+        }
+
+        // otherwise the pid was reused without its exit reaching us.
+        forget_process(ctx, ProcessInfo { ctx.processTree.name(process.pid), process.pid });
+    }
+
+    ctx.processTree.insert(process.pid, process.parentPid, process.name);
+    ctx.eventLog.push(EventLogKind::STARTED, process.pid, process.name);
+
+    lock_if_protected(ctx, std::move(process), receivedAt);
+}
+
+void process_deletion_handler(ProcessListenerContext& ctx, ProcessInfo const& process)
+{
+    // a rescan got to it first, and the pid may already belong to someone else.
+    if (!ctx.processTree.contains(process.pid) || ctx.processTree.name(process.pid) != process.name) return;
+
+    ctx.processTree.erase(process.pid);
+    forget_process(ctx, process);
+}
+
+void process_replacement_handler(ProcessListenerContext& ctx, ProcessInfo process, std::chrono::steady_clock::time_point receivedAt)
+{
+    // the fork was missed, so as far as we know it starts here.
+    if (!ctx.processTree.contains(process.pid))
+    {
+        process_creation_handler(ctx, std::move(process), receivedAt);
+        return;
+    }
+
+    if (ctx.processTree.name(process.pid) == process.name) return;
+
+    ctx.processTree.rename(process.pid, process.name);
+    ctx.eventLog.push(EventLogKind::STARTED, process.pid, process.name);
+
+    lock_if_protected(ctx, std::move(process), receivedAt);
+}
+
+bool process_rescan_handler(ProcessListenerContext& ctx, ProcessTable const& processes)
+{
+    thread_local ProcessTreeChanges missed {};
+    missed.started.clear();
+    missed.exited.clear();
+    missed.moved.clear();
+
+    auto const generation = ctx.processTree.generation();
+    ctx.processTree.reconcile(processes, missed);
+
+    // the exits go first, a reused pid has to be forgotten before its new process can be locked.
+    for (auto const& process : missed.exited)
+    {
+        forget_process(ctx, process);
+    }
+
+    auto const discoveredAt = std::chrono::steady_clock::now();
+
+    for (auto const& process : missed.started)
+    {
+        ctx.unannouncedProcesses.insert(process.pid);
+        ctx.eventLog.push(EventLogKind::STARTED, process.pid, process.name);
+        lock_if_protected(ctx, process, discoveredAt);
+    }
+
+    for (auto const pid : missed.moved)
+    {
+        lock_subtree_if_protected(ctx, pid, discoveredAt);
+    }
+
+    return ctx.processTree.generation() != generation;
+}
+
+void process_suspension_handler(ProcessListenerContext& ctx)
+{
+    if (ctx.suspensionQueue.empty()) return;
+
+    // the queue is the batch, and whatever fails in it is left running, so it goes into the next one instead of being dropped.
+    auto const& batch = ctx.suspensionQueue.processes;
+    SuspensionQueue retries {};
+
+    auto const results = ctx.controller.suspend(batch);
+
+    for (auto const& [processInfo, program, attempt, result] : std::views::zip(batch, ctx.suspensionQueue.programs, ctx.suspensionQueue.attempts, results))
+    {
+        if (!result.result)
+        {
+            spdlog::error("Failed to suspend {} ({}): {}", processInfo.name, result.pid, result.result.error().message());
+            ctx.eventLog.push(EventLogKind::SUSPEND_FAILED, processInfo.pid, processInfo.name);
+
+            if (ctx.controller.has_exited(processInfo))
+            {
+                ctx.enforcementTraces.erase(processInfo.pid);
+            }
+            else if (attempt + 1 < SuspensionQueue::MAX_ATTEMPTS)
+            {
+                retries.push(processInfo, program, attempt + 1);
+            }
+            else
+            {
+                spdlog::error("Giving up on suspending {} ({}) after {} attempts", processInfo.name, processInfo.pid, SuspensionQueue::MAX_ATTEMPTS);
+                ctx.enforcementTraces.erase(processInfo.pid);
+            }
+
+            continue;
+        }
+
+        auto trace = ctx.enforcementTraces.extract(processInfo.pid);
+        ctx.eventLog.push(EventLogKind::SUSPENDED, processInfo.pid, processInfo.name);
+
+        if (!trace.empty())
+        {
+            trace.mapped().issued = result.issued;
+            trace.mapped().confirmed = result.confirmed;
+            ctx.enforcementLatency.record(trace.mapped());
+        }
+
+        ctx.suspendedProcesses[program].push_back(processInfo);
+    }
+
+    std::swap(ctx.suspensionQueue, retries);
+}
+
+void process_resumption_handler(ProcessListenerContext& ctx, std::string_view password)
+{
+    std::vector<ProcessInfo> batch {};
+    std::vector<std::string_view> programs {};
+    for (auto& process : ctx.suspendedProcesses)
+    {
+        if (ctx.protectedPrograms.at(process.first) != password) continue;
+        batch.append_range(process.second);
+        programs.insert(programs.end(), process.second.size(), process.first);
+    }
+
+    for (auto const& [processInfo, program, result] : std::views::zip(batch, programs, ctx.controller.resume(batch)))
+    {
+        if (!result.result)
+        {
+            spdlog::error("Failed to resume {} ({}): {}", processInfo.name, result.pid, result.result.error().message());
+        }
+
+        ctx.eventLog.push(result.result ? EventLogKind::RESUMED : EventLogKind::RESUME_FAILED, processInfo.pid, processInfo.name);
+
+        // dropped from the suspended set either way, a failed resume almost always means the process is gone.
+        ctx.resumedProcesses[std::string(program)].push_back(processInfo);
+    }
+
+    std::ranges::for_each(ctx.resumedProcesses, [&] (auto&& resumedProcess) {
+        ctx.suspendedProcesses.erase(resumedProcess.first);
+    });
+}
@@ -0,0 +1,228 @@
+#include "TableRows.hpp"
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+std::weak_ordering compare_names(std::string_view lhs, std::string_view rhs)
+{
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [] (char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) <=> std::tolower(static_cast<unsigned char>(b));
+    });
+}
+
+GroupUsage group_usage(ProcessUsageSnapshot const& snapshot, std::vector<ProcessInfo> const& processes)
+{
+    GroupUsage usage {};
+
+    for (auto const& process : processes)
+    {
+        auto const* sample = snapshot.find(process.pid);
+        if (sample == nullptr) continue;
+        usage.cpuPercent += sample->cpuPercent;
+        usage.residentBytes += sample->residentBytes;
+        usage.sampled = true;
+        usage.hasRate = usage.hasRate || sample->hasRate;
+    }
+
+    return usage;
+}
+
+void flatten_process_tree(ProcessTree const& tree, std::unordered_set<ProcessId> const& expanded, std::vector<ProcessTreeRow>& rows, std::vector<ProcessTreeRow>& pending)
+{
+    rows.clear();
+    pending.clear();
+
+    auto const fnPushChildren = [&] (ProcessId pid, int depth) {
+        auto const first = pending.size();
+        std::ranges::transform(tree.children(pid), std::back_inserter(pending), [depth] (ProcessId child) { return ProcessTreeRow { child, depth }; });
+
+        // pending is a stack, so the siblings go on in reverse to come off in order.
+        std::ranges::sort(std::span(pending).subspan(first), [&] (ProcessTreeRow const& lhs, ProcessTreeRow const& rhs) {
+            auto const order = compare_names(tree.name(lhs.pid), tree.name(rhs.pid));
+            return order == 0 ? lhs.pid > rhs.pid : order > 0;
+        });
+    };
+
+    fnPushChildren(ProcessTree::ROOT, 0);
+
+    while (!pending.empty())
+    {
+        auto const row = pending.back();
+        pending.pop_back();
+        rows.push_back(row);
+
+        if (expanded.contains(row.pid)) fnPushChildren(row.pid, row.depth + 1);
+    }
+}
+
+int process_table_rows(std::span<ProcessGroup const* const> rows, ProcessUsageSnapshot const& usage, int selectedRow, VisibleRanges& visible)
+{
+    auto clickedRow = -1;
+
+    ImGuiListClipper clipper {};
+    clipper.Begin(static_cast<int>(rows.size()));
+
+    NoAllocationScope noAllocations {};
+
+    while (clipper.Step())
+    {
+        visible.push(clipper.DisplayStart, clipper.DisplayEnd);
+
+        for (auto rowIndex = clipper.DisplayStart; rowIndex < clipper.DisplayEnd; rowIndex += 1)
+        {
+            auto const& process = *rows[static_cast<std::size_t>(rowIndex)];
+            auto const groupUsage = group_usage(usage, process.second);
+            bool selected = rowIndex == selectedRow;
+
+            ImGui::TableNextRow();
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", process.first.data());
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", process.second.front().pid);
+            ImGui::TableNextColumn();
+            if (groupUsage.hasRate) ImGui::Text("%.1f%%", static_cast<double>(groupUsage.cpuPercent));
+            else ImGui::TextUnformatted("-");
+            ImGui::TableNextColumn();
+            if (groupUsage.sampled) ImGui::Text("%.1f MB", static_cast<double>(groupUsage.residentBytes) / (1024.0 * 1024.0));
+            else ImGui::TextUnformatted("-");
+
+            ImGui::TableSetColumnIndex(0);
+            ImGui::PushID(rowIndex);
+            if (ImGui::Selectable("##row", selected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick))
+            {
+                clickedRow = rowIndex;
+            }
+            ImGui::PopID();
+        }
+    }
+
+    return clickedRow;
+}
+
+ProcessTreeClicks process_tree_rows(ProcessTree const& tree, std::span<ProcessTreeRow const> rows, std::unordered_set<ProcessId> const& expanded, ProcessId selectedPid, ProcessUsageSnapshot const& usage, ImGuiStorage& nodeState, VisibleRanges& visible)
+{
+    ProcessTreeClicks clicks {};
+
+    ImGuiListClipper clipper {};
+    clipper.Begin(static_cast<int>(rows.size()));
+
+    auto* const windowState = ImGui::GetStateStorage();
+    ImGui::SetStateStorage(&nodeState);
+
+    {
+        NoAllocationScope noAllocations {};
+
+        while (clipper.Step())
+        {
+            visible.push(clipper.DisplayStart, clipper.DisplayEnd);
+
+            for (auto rowIndex = clipper.DisplayStart; rowIndex < clipper.DisplayEnd; rowIndex += 1)
+            {
+                auto const row = rows[static_cast<std::size_t>(rowIndex)];
+                auto const open = expanded.contains(row.pid);
+                auto const* sample = usage.find(row.pid);
+
+                ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanAllColumns | ImGuiTreeNodeFlags_NoTreePushOnOpen | ImGuiTreeNodeFlags_OpenOnArrow;
+                if (tree.children(row.pid).empty()) flags |= ImGuiTreeNodeFlags_Leaf;
+                if (row.pid == selectedPid) flags |= ImGuiTreeNodeFlags_Selected;
+
+                ImGui::TableNextRow();
+
+                // the nodes don't push onto the tree stack, so each row indents itself by its depth.
+                ImGui::TableNextColumn();
+                ImGui::SetCursorPosX(ImGui::GetCursorPosX() + static_cast<float>(row.depth) * ImGui::GetStyle().IndentSpacing);
+                ImGui::PushID(static_cast<int>(row.pid));
+                ImGui::SetNextItemOpen(open);
+                if (ImGui::TreeNodeEx("##node", flags, "%s", tree.name(row.pid).data()) != open) clicks.toggled = row.pid;
+                if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) clicks.clicked = row.pid;
+                ImGui::PopID();
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", row.pid);
+                ImGui::TableNextColumn();
+                if (sample != nullptr && sample->hasRate) ImGui::Text("%.1f%%", static_cast<double>(sample->cpuPercent));
+                else ImGui::TextUnformatted("-");
+                ImGui::TableNextColumn();
+                if (sample != nullptr) ImGui::Text("%.1f MB", static_cast<double>(sample->residentBytes) / (1024.0 * 1024.0));
+                else ImGui::TextUnformatted("-");
+            }
+        }
+    }
+
+    ImGui::SetStateStorage(windowState);
+
+    return clicks;
+}
+
+// the open state always comes from expanded, so whatever ImGui stored for the previous rows can go.
+void reserve_node_state(ImGuiStorage& nodeState, std::size_t rowCount)
+{
+    nodeState.Data.resize(0);
+    nodeState.Data.reserve(static_cast<int>(rowCount));
+}
+
+int protected_program_rows(std::span<ProtectedProgram const* const> rows, int selectedRow)
+{
+    auto clickedRow = -1;
+
+    ImGuiListClipper clipper {};
+    clipper.Begin(static_cast<int>(rows.size()));
+
+    NoAllocationScope noAllocations {};
+
+    while (clipper.Step())
+    {
+        for (auto rowIndex = clipper.DisplayStart; rowIndex < clipper.DisplayEnd; rowIndex += 1)
+        {
+            auto const& program = *rows[static_cast<std::size_t>(rowIndex)];
+            bool selected = rowIndex == selectedRow;
+
+            ImGui::TableNextRow();
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", program.first.data());
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", program.second.data());
+
+            ImGui::TableSetColumnIndex(0);
+            ImGui::PushID(rowIndex);
+            if (ImGui::Selectable("##row", selected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick))
+            {
+                clickedRow = rowIndex;
+            }
+            ImGui::PopID();
+        }
+    }
+
+    return clickedRow;
+}
+
+void event_log_rows(EventLog const& log, std::chrono::steady_clock::time_point startedAt)
+{
+    ImGuiListClipper clipper {};
+    clipper.Begin(static_cast<int>(log.size()));
+
+    NoAllocationScope noAllocations {};
+
+    while (clipper.Step())
+    {
+        for (auto rowIndex = clipper.DisplayStart; rowIndex < clipper.DisplayEnd; rowIndex += 1)
+        {
+            auto const& entry = log[static_cast<std::size_t>(rowIndex)];
+
+            ImGui::TableNextRow();
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3fs", std::chrono::duration<double>(entry.at - startedAt).count());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(to_string(entry.kind));
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", entry.pid);
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", entry.name.data());
+        }
+    }
+}
@@ -208,6 +208,15 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 4.4+ (or GL_ARB_buffer_storage) has glBufferStorage() for persistently mapped buffers, which we stream vertices through.
+// Relies on glDrawElementsBaseVertex() to address each frame's segment. '#define IMGUI_IMPL_OPENGL_DISABLE_PERSISTENT_BUFFERS' to always use glBufferData().
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET) && defined(GL_MAP_PERSISTENT_BIT) && !defined(IMGUI_IMPL_OPENGL_DISABLE_PERSISTENT_BUFFERS)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#define IMGUI_IMPL_OPENGL_STREAM_SEGMENTS       3       // Frames the CPU may write ahead of the GPU before waiting on a fence
+#define IMGUI_IMPL_OPENGL_STREAM_MIN_VERTICES   65536
+#define IMGUI_IMPL_OPENGL_STREAM_MIN_INDICES    131072
+#endif
+
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
 #ifdef IMGUI_IMPL_OPENGL_DEBUG
@@ -239,6 +248,15 @@ struct ImGui_ImplOpenGL3_Data
     bool            HasPolygonMode;
     bool            HasClipOrigin;
     bool            UseBufferSubData;
+    bool            UsePersistentBuffers;    // Stream through persistently mapped ring buffers instead of glBufferData(), see ImGui_ImplOpenGL3_UploadStreamBuffers()
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    GLsizeiptr      StreamVtxCapacity;       // Per segment, in vertices
+    GLsizeiptr      StreamIdxCapacity;       // Per segment, in indices
+    ImDrawVert*     StreamVtxData;           // Mapped for the lifetime of the buffers, IMGUI_IMPL_OPENGL_STREAM_SEGMENTS segments back to back
+    ImDrawIdx*      StreamIdxData;
+    GLsync          StreamFences[IMGUI_IMPL_OPENGL_STREAM_SEGMENTS];
+    int             StreamSegment;
+#endif
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -371,6 +389,9 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     bd->HasPolygonMode = (!bd->GlProfileIsES2 && !bd->GlProfileIsES3);
 #endif
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    bool has_buffer_storage = (bd->GlVersion >= 440);
+#endif
 #ifdef IMGUI_IMPL_OPENGL_HAS_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -379,8 +400,16 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != nullptr && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+        if (extension != nullptr && strcmp(extension, "GL_ARB_buffer_storage") == 0)
+            has_buffer_storage = true;
+#endif
     }
 #endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    // The extension alone isn't enough, every segment past the first is addressed with a base vertex.
+    bd->UsePersistentBuffers = has_buffer_storage && bd->GlVersion >= 320 && !bd->GlProfileIsES3 && glBufferStorage != nullptr && glMapBufferRange != nullptr && glFenceSync != nullptr;
+#endif
 
     return true;
 }
@@ -483,6 +512,94 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col)));
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static void ImGui_ImplOpenGL3_DestroyStreamBuffers(ImGui_ImplOpenGL3_Data* bd)
+{
+    // The GL keeps deleted buffers alive until the draws still reading them have completed, and unmaps them for us.
+    for (GLsync& fence : bd->StreamFences)
+        if (fence) { glDeleteSync(fence); fence = nullptr; }
+    if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
+    if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
+    bd->StreamVtxCapacity = bd->StreamIdxCapacity = 0;
+    bd->StreamVtxData = nullptr;
+    bd->StreamIdxData = nullptr;
+    bd->StreamSegment = 0;
+}
+
+static bool ImGui_ImplOpenGL3_CreateStreamBuffers(ImGui_ImplOpenGL3_Data* bd, GLsizeiptr vtx_capacity, GLsizeiptr idx_capacity)
+{
+    // Storage from glBufferStorage() is immutable, so growing means starting over with new buffers.
+    // They are set up through GL_COPY_WRITE_BUFFER, which unlike GL_ELEMENT_ARRAY_BUFFER isn't part of the bound VAO's state.
+    ImGui_ImplOpenGL3_DestroyStreamBuffers(bd);
+    glGenBuffers(1, &bd->VboHandle);
+    glGenBuffers(1, &bd->ElementsHandle);
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr vtx_buffer_size = IMGUI_IMPL_OPENGL_STREAM_SEGMENTS * vtx_capacity * (GLsizeiptr)sizeof(ImDrawVert);
+    const GLsizeiptr idx_buffer_size = IMGUI_IMPL_OPENGL_STREAM_SEGMENTS * idx_capacity * (GLsizeiptr)sizeof(ImDrawIdx);
+    GLint last_copy_write_buffer; glGetIntegerv(GL_COPY_WRITE_BUFFER, &last_copy_write_buffer);
+    GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, bd->VboHandle));
+    GL_CALL(glBufferStorage(GL_COPY_WRITE_BUFFER, vtx_buffer_size, nullptr, flags));
+    bd->StreamVtxData = (ImDrawVert*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, vtx_buffer_size, flags);
+    GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, bd->ElementsHandle));
+    GL_CALL(glBufferStorage(GL_COPY_WRITE_BUFFER, idx_buffer_size, nullptr, flags));
+    bd->StreamIdxData = (ImDrawIdx*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, idx_buffer_size, flags);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, (GLuint)last_copy_write_buffer);
+
+    if (bd->StreamVtxData == nullptr || bd->StreamIdxData == nullptr)
+    {
+        // Leave plain buffers behind for the glBufferData() path to fall back on.
+        ImGui_ImplOpenGL3_DestroyStreamBuffers(bd);
+        glGenBuffers(1, &bd->VboHandle);
+        glGenBuffers(1, &bd->ElementsHandle);
+        return false;
+    }
+
+    bd->StreamVtxCapacity = vtx_capacity;
+    bd->StreamIdxCapacity = idx_capacity;
+    return true;
+}
+
+// Copy every draw list of the frame into the next segment of the ring, after waiting for the GPU to be done with what was last drawn from it.
+// With three segments that wait only ever blocks when the CPU gets a whole two frames ahead of the GPU.
+static bool ImGui_ImplOpenGL3_UploadStreamBuffers(ImGui_ImplOpenGL3_Data* bd, ImDrawData* draw_data)
+{
+    if (bd->StreamVtxCapacity < draw_data->TotalVtxCount || bd->StreamIdxCapacity < draw_data->TotalIdxCount)
+    {
+        // Half again what this frame needs, so a table that keeps growing doesn't recreate the buffers every frame.
+        GLsizeiptr vtx_capacity = (GLsizeiptr)draw_data->TotalVtxCount + draw_data->TotalVtxCount / 2;
+        GLsizeiptr idx_capacity = (GLsizeiptr)draw_data->TotalIdxCount + draw_data->TotalIdxCount / 2;
+        if (vtx_capacity < IMGUI_IMPL_OPENGL_STREAM_MIN_VERTICES) vtx_capacity = IMGUI_IMPL_OPENGL_STREAM_MIN_VERTICES;
+        if (idx_capacity < IMGUI_IMPL_OPENGL_STREAM_MIN_INDICES) idx_capacity = IMGUI_IMPL_OPENGL_STREAM_MIN_INDICES;
+        if (!ImGui_ImplOpenGL3_CreateStreamBuffers(bd, vtx_capacity, idx_capacity))
+            return false;
+    }
+
+    bd->StreamSegment = (bd->StreamSegment + 1) % IMGUI_IMPL_OPENGL_STREAM_SEGMENTS;
+    if (GLsync& fence = bd->StreamFences[bd->StreamSegment])
+    {
+        GLenum wait_result;
+        do
+            wait_result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000); // 1 second, in nanoseconds
+        while (wait_result == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    ImDrawVert* vtx_dst = bd->StreamVtxData + bd->StreamSegment * bd->StreamVtxCapacity;
+    ImDrawIdx* idx_dst = bd->StreamIdxData + bd->StreamSegment * bd->StreamIdxCapacity;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        memcpy(vtx_dst, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        memcpy(idx_dst, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        vtx_dst += draw_list->VtxBuffer.Size;
+        idx_dst += draw_list->IdxBuffer.Size;
+    }
+    return true;
+}
+#endif
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -535,6 +652,22 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     GLboolean last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
 #endif
 
+    // Upload the whole frame up front when streaming through persistent buffers, which may have to be recreated before they are bound below.
+    // Each draw list then starts at its running offset into the frame's segment.
+    GLsizeiptr global_vtx_offset = 0;
+    GLsizeiptr global_idx_offset = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->UsePersistentBuffers)
+    {
+        bd->UsePersistentBuffers = ImGui_ImplOpenGL3_UploadStreamBuffers(bd, draw_data);
+        if (bd->UsePersistentBuffers)
+        {
+            global_vtx_offset = bd->StreamSegment * bd->StreamVtxCapacity;
+            global_idx_offset = bd->StreamSegment * bd->StreamIdxCapacity;
+        }
+    }
+#endif
+
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
@@ -563,7 +696,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         // - See https://github.com/ocornut/imgui/issues/4468 and please report any corruption issues.
         const GLsizeiptr vtx_buffer_size = (GLsizeiptr)draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
         const GLsizeiptr idx_buffer_size = (GLsizeiptr)draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
-        if (bd->UseBufferSubData)
+        if (bd->UsePersistentBuffers)
+        {
+            // Already in place, see ImGui_ImplOpenGL3_UploadStreamBuffers()
+        }
+        else if (bd->UseBufferSubData)
         {
             if (bd->VertexBufferSize < vtx_buffer_size)
             {
@@ -611,14 +748,26 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
-                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
+                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)((global_idx_offset + pcmd->IdxOffset) * sizeof(ImDrawIdx)), (GLint)(global_vtx_offset + pcmd->VtxOffset)));
                 else
 #endif
                 GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))));
             }
         }
+
+        if (bd->UsePersistentBuffers)
+        {
+            global_vtx_offset += draw_list->VtxBuffer.Size;
+            global_idx_offset += draw_list->IdxBuffer.Size;
+        }
     }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    // Guards the segment until the GPU is through with this frame's draws.
+    if (bd->UsePersistentBuffers)
+        bd->StreamFences[bd->StreamSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+
     // Destroy the temporary VAO
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
@@ -948,6 +1097,9 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    ImGui_ImplOpenGL3_DestroyStreamBuffers(bd);
+#endif
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
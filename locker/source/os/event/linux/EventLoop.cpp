@@ -0,0 +1,120 @@
+#include "os/event/EventLoop.hpp"
+
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+using namespace liberror;
+
+EventLoop::EventLoop()
+    : epoll(epoll_create1(EPOLL_CLOEXEC))
+{
+    MUST(watch(wakeSignal.handle(), [this] { wakeSignal.reset(); }));
+}
+
+EventLoop::~EventLoop()
+{
+    for (auto const& watch : watches)
+    {
+        if (watch.timer) close(watch.handle);
+    }
+
+    close(epoll);
+}
+
+Result<void> EventLoop::watch(EventHandle handle, std::function<void()> callback)
+{
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = handle;
+
+    if (epoll_ctl(epoll, EPOLL_CTL_ADD, handle, &event) != 0)
+    {
+        return make_error("epoll_ctl failed with: {}", std::strerror(errno));
+    }
+
+    watches.emplace_back(handle, std::move(callback), false);
+
+    return {};
+}
+
+void EventLoop::unwatch(EventHandle handle)
+{
+    auto const position = std::ranges::find(watches, handle, &Watch::handle);
+    if (position == watches.end() || position == watches.begin()) return;
+
+    epoll_ctl(epoll, EPOLL_CTL_DEL, handle, nullptr);
+    if (position->timer) close(position->handle);
+    watches.erase(position);
+}
+
+Result<void> EventLoop::add_timer(std::chrono::milliseconds interval, std::function<void()> callback)
+{
+    auto timer = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (timer < 0)
+    {
+        return make_error("timerfd_create failed with: {}", std::strerror(errno));
+    }
+
+    auto const seconds = std::chrono::duration_cast<std::chrono::seconds>(interval);
+    auto const nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(interval - seconds);
+
+    itimerspec specification {};
+    specification.it_interval.tv_sec = seconds.count();
+    specification.it_interval.tv_nsec = nanoseconds.count();
+    specification.it_value = specification.it_interval;
+
+    if (timerfd_settime(timer, 0, &specification, nullptr) != 0)
+    {
+        close(timer);
+        return make_error("timerfd_settime failed with: {}", std::strerror(errno));
+    }
+
+    if (auto result = watch(timer, std::move(callback)); !result)
+    {
+        close(timer);
+        return result;
+    }
+
+    watches.back().timer = true;
+
+    return {};
+}
+
+Result<void> EventLoop::run_once()
+{
+    std::array<epoll_event, 16> events {};
+
+    auto const count = epoll_wait(epoll, events.data(), static_cast<int>(events.size()), -1);
+
+    if (count < 0)
+    {
+        if (errno == EINTR) return {};
+        return make_error("epoll_wait failed with: {}", std::strerror(errno));
+    }
+
+    for (auto const& event : std::span { events.data(), static_cast<std::size_t>(count) })
+    {
+        auto const position = std::ranges::find(watches, event.data.fd, &Watch::handle);
+        if (position == watches.end()) continue;
+
+        if (position->timer)
+        {
+            std::uint64_t expirations = 0;
+            [[maybe_unused]] auto const _ = read(position->handle, &expirations, sizeof(expirations));
+        }
+
+        // copied out since the callback is free to watch or unwatch handles.
+        auto const callback = position->callback;
+        callback();
+    }
+
+    return {};
+}
@@ -0,0 +1,27 @@
+#include "os/event/EventSignal.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+EventSignal::EventSignal()
+    : event(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{}
+
+EventSignal::~EventSignal()
+{
+    close(event);
+}
+
+void EventSignal::raise() const
+{
+    std::uint64_t const increment = 1;
+    [[maybe_unused]] auto const _ = write(event, &increment, sizeof(increment));
+}
+
+void EventSignal::reset() const
+{
+    std::uint64_t counter = 0;
+    [[maybe_unused]] auto const _ = read(event, &counter, sizeof(counter));
+}
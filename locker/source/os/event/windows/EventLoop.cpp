@@ -0,0 +1,90 @@
+#include "os/event/EventLoop.hpp"
+
+#include <algorithm>
+
+using namespace liberror;
+
+EventLoop::EventLoop()
+{
+    watches.emplace_back(wakeSignal.handle(), [] {}, false);
+}
+
+EventLoop::~EventLoop()
+{
+    for (auto const& watch : watches)
+    {
+        if (watch.timer) CloseHandle(watch.handle);
+    }
+}
+
+Result<void> EventLoop::watch(EventHandle handle, std::function<void()> callback)
+{
+    if (watches.size() == MAXIMUM_WAIT_OBJECTS)
+    {
+        return make_error("EventLoop can't wait on more than {} handles", MAXIMUM_WAIT_OBJECTS);
+    }
+
+    watches.emplace_back(handle, std::move(callback), false);
+
+    return {};
+}
+
+void EventLoop::unwatch(EventHandle handle)
+{
+    auto const position = std::ranges::find(watches, handle, &Watch::handle);
+    if (position == watches.end() || position == watches.begin()) return;
+    if (position->timer) CloseHandle(position->handle);
+    watches.erase(position);
+}
+
+Result<void> EventLoop::add_timer(std::chrono::milliseconds interval, std::function<void()> callback)
+{
+    auto timer = CreateWaitableTimerW(nullptr, FALSE, nullptr);
+    if (timer == nullptr)
+    {
+        return make_error("CreateWaitableTimer failed with: {:x}", GetLastError());
+    }
+
+    // negative due times are relative, in 100ns units.
+    LARGE_INTEGER dueTime {};
+    dueTime.QuadPart = -std::chrono::duration_cast<std::chrono::duration<LONGLONG, std::ratio<1, 10'000'000>>>(interval).count();
+
+    if (!SetWaitableTimer(timer, &dueTime, static_cast<LONG>(interval.count()), nullptr, nullptr, FALSE))
+    {
+        CloseHandle(timer);
+        return make_error("SetWaitableTimer failed with: {:x}", GetLastError());
+    }
+
+    if (auto result = watch(timer, std::move(callback)); !result)
+    {
+        CloseHandle(timer);
+        return result;
+    }
+
+    watches.back().timer = true;
+
+    return {};
+}
+
+Result<void> EventLoop::run_once()
+{
+    std::vector<HANDLE> handles {};
+    handles.reserve(watches.size());
+    std::ranges::transform(watches, std::back_inserter(handles), &Watch::handle);
+
+    auto const result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, INFINITE);
+
+    if (result == WAIT_FAILED)
+    {
+        return make_error("WaitForMultipleObjects failed with: {:x}", GetLastError());
+    }
+
+    auto const index = result - WAIT_OBJECT_0;
+    if (index >= watches.size()) return {};
+
+    // copied out since the callback is free to watch or unwatch handles.
+    auto const callback = watches[index].callback;
+    callback();
+
+    return {};
+}
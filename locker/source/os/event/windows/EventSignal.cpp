@@ -0,0 +1,20 @@
+#include "os/event/EventSignal.hpp"
+
+EventSignal::EventSignal()
+    : event(CreateEventW(nullptr, FALSE, FALSE, nullptr))
+{}
+
+EventSignal::~EventSignal()
+{
+    CloseHandle(event);
+}
+
+void EventSignal::raise() const
+{
+    SetEvent(event);
+}
+
+void EventSignal::reset() const
+{
+    ResetEvent(event);
+}
@@ -0,0 +1,110 @@
+#include "os/memory/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+using namespace liberror;
+
+MappedFile::~MappedFile()
+{
+    unmap();
+    if (file >= 0) close(file);
+}
+
+MappedFile::MappedFile(MappedFile&& that) noexcept
+    : file(std::exchange(that.file, -1))
+    , view(std::exchange(that.view, nullptr))
+    , size(std::exchange(that.size, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& that) noexcept
+{
+    if (this == &that) return *this;
+
+    unmap();
+    if (file >= 0) close(file);
+
+    file = std::exchange(that.file, -1);
+    view = std::exchange(that.view, nullptr);
+    size = std::exchange(that.size, 0);
+
+    return *this;
+}
+
+// the old view stays in place until the new one is, so a failure leaves the file mapped as it was.
+Result<void> MappedFile::map(std::size_t newSize)
+{
+    struct stat status {};
+    if (fstat(file, &status) != 0)
+    {
+        return make_error("fstat failed with: {}", std::strerror(errno));
+    }
+
+    if (static_cast<std::size_t>(status.st_size) < newSize && ftruncate(file, static_cast<off_t>(newSize)) != 0)
+    {
+        return make_error("ftruncate failed with: {}", std::strerror(errno));
+    }
+
+    auto* mapping = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (mapping == MAP_FAILED)
+    {
+        return make_error("mmap failed with: {}", std::strerror(errno));
+    }
+
+    if (view != nullptr) munmap(view, size);
+    view = mapping;
+    size = newSize;
+
+    return {};
+}
+
+void MappedFile::unmap()
+{
+    if (view != nullptr) munmap(view, size);
+    view = nullptr;
+    size = 0;
+}
+
+Result<void> MappedFile::resize(std::size_t newSize)
+{
+    if (newSize <= size) return {};
+    return map(newSize);
+}
+
+Result<void> MappedFile::flush() const
+{
+    if (msync(view, size, MS_SYNC) != 0)
+    {
+        return make_error("msync failed with: {}", std::strerror(errno));
+    }
+
+    return {};
+}
+
+Result<MappedFile> map_file(std::filesystem::path const& path, std::size_t minimumSize)
+{
+    MappedFile mappedFile {};
+
+    mappedFile.file = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (mappedFile.file < 0)
+    {
+        return make_error("open failed to open {} with: {}", path.string(), std::strerror(errno));
+    }
+
+    struct stat status {};
+    if (fstat(mappedFile.file, &status) != 0)
+    {
+        return make_error("fstat failed with: {}", std::strerror(errno));
+    }
+
+    TRY(mappedFile.map(std::max(static_cast<std::size_t>(status.st_size), minimumSize)));
+
+    return mappedFile;
+}
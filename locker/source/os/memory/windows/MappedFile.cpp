@@ -0,0 +1,109 @@
+#include "os/memory/MappedFile.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace liberror;
+
+MappedFile::~MappedFile()
+{
+    unmap();
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+}
+
+MappedFile::MappedFile(MappedFile&& that) noexcept
+    : file(std::exchange(that.file, INVALID_HANDLE_VALUE))
+    , mapping(std::exchange(that.mapping, nullptr))
+    , view(std::exchange(that.view, nullptr))
+    , size(std::exchange(that.size, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& that) noexcept
+{
+    if (this == &that) return *this;
+
+    unmap();
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+
+    file = std::exchange(that.file, INVALID_HANDLE_VALUE);
+    mapping = std::exchange(that.mapping, nullptr);
+    view = std::exchange(that.view, nullptr);
+    size = std::exchange(that.size, 0);
+
+    return *this;
+}
+
+// the old view stays in place until the new one is, so a failure leaves the file mapped as it was.
+Result<void> MappedFile::map(std::size_t newSize)
+{
+    // mapping past the end of the file extends it, which is how the file grows.
+    auto const sizeHigh = static_cast<DWORD>(static_cast<unsigned long long>(newSize) >> 32);
+    auto const sizeLow = static_cast<DWORD>(newSize & 0xFFFFFFFF);
+
+    auto newMapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, sizeHigh, sizeLow, nullptr);
+    if (newMapping == nullptr)
+    {
+        return make_error("CreateFileMapping failed with: {:x}", GetLastError());
+    }
+
+    auto* newView = MapViewOfFile(newMapping, FILE_MAP_ALL_ACCESS, 0, 0, newSize);
+    if (newView == nullptr)
+    {
+        auto const error = GetLastError();
+        CloseHandle(newMapping);
+        return make_error("MapViewOfFile failed with: {:x}", error);
+    }
+
+    unmap();
+    mapping = newMapping;
+    view = newView;
+    size = newSize;
+
+    return {};
+}
+
+void MappedFile::unmap()
+{
+    if (view != nullptr) UnmapViewOfFile(view);
+    if (mapping != nullptr) CloseHandle(mapping);
+    view = nullptr;
+    mapping = nullptr;
+    size = 0;
+}
+
+Result<void> MappedFile::resize(std::size_t newSize)
+{
+    if (newSize <= size) return {};
+    return map(newSize);
+}
+
+Result<void> MappedFile::flush() const
+{
+    if (!FlushViewOfFile(view, size))
+    {
+        return make_error("FlushViewOfFile failed with: {:x}", GetLastError());
+    }
+
+    return {};
+}
+
+Result<MappedFile> map_file(std::filesystem::path const& path, std::size_t minimumSize)
+{
+    MappedFile mappedFile {};
+
+    mappedFile.file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mappedFile.file == INVALID_HANDLE_VALUE)
+    {
+        return make_error("CreateFile failed to open {} with: {:x}", path.string(), GetLastError());
+    }
+
+    LARGE_INTEGER fileSize {};
+    if (!GetFileSizeEx(mappedFile.file, &fileSize))
+    {
+        return make_error("GetFileSizeEx failed with: {:x}", GetLastError());
+    }
+
+    TRY(mappedFile.map(std::max(static_cast<std::size_t>(fileSize.QuadPart), minimumSize)));
+
+    return mappedFile;
+}
@@ -0,0 +1,109 @@
+#include "os/process/ProcessEventQueue.hpp"
+
+#include <bit>
+#include <thread>
+
+ProcessEventQueue::ProcessEventQueue(std::size_t capacity)
+    : mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1)
+    , slots(std::make_unique<Slot[]>(mask + 1))
+{
+    for (auto slot = 0zu; slot <= mask; slot += 1)
+    {
+        slots[slot].sequence.store(slot, std::memory_order_relaxed);
+    }
+
+    drained.reserve(mask + 1);
+}
+
+bool ProcessEventQueue::push(ProcessEvent const& event)
+{
+    // how many times a producer yields to the consumer before it gives up on the event.
+    constexpr auto MAX_BACKOFF_ROUNDS = 64;
+
+    auto position = tail.load(std::memory_order_relaxed);
+    auto backoff = 0;
+
+    while (true)
+    {
+        auto& slot = slots[position & mask];
+        auto const sequence = slot.sequence.load(std::memory_order_acquire);
+        auto const difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (difference == 0)
+        {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.event = event;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // the slot still holds an event from the previous lap, so the ring is full.
+            if (backoff == MAX_BACKOFF_ROUNDS)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            if (backoff == 0) backpressure.fetch_add(1, std::memory_order_relaxed);
+            backoff += 1;
+
+            std::this_thread::yield();
+            position = tail.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    pushed.fetch_add(1, std::memory_order_relaxed);
+
+    // pairs with the fence in drain(): either the consumer sees this event or we see pending cleared and wake it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!pending.exchange(true, std::memory_order_acq_rel)) signal.raise();
+
+    return true;
+}
+
+std::vector<ProcessEvent> const& ProcessEventQueue::drain()
+{
+    signal.reset();
+    pending.store(false, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    drained.clear();
+
+    // bounded by the capacity, so producers that keep refilling the ring can't make a drain unbounded or grow drained.
+    while (drained.size() <= mask)
+    {
+        auto& slot = slots[head & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) break;
+
+        drained.push_back(slot.event);
+        slot.sequence.store(head + mask + 1, std::memory_order_release);
+        head += 1;
+    }
+
+    if (slots[head & mask].sequence.load(std::memory_order_acquire) == head + 1)
+    {
+        // whatever didn't fit already had its wake-up swallowed above, so ask for another round.
+        signal.raise();
+    }
+
+    highWatermark.store(std::max(highWatermark.load(std::memory_order_relaxed), drained.size()), std::memory_order_relaxed);
+
+    return drained;
+}
+
+ProcessEventQueueStatistics ProcessEventQueue::statistics() const
+{
+    return {
+        .pushed = pushed.load(std::memory_order_relaxed),
+        .dropped = dropped.load(std::memory_order_relaxed),
+        .backpressure = backpressure.load(std::memory_order_relaxed),
+        .highWatermark = highWatermark.load(std::memory_order_relaxed),
+    };
+}
@@ -0,0 +1,152 @@
+#include "os/process/ProcessTree.hpp"
+
+#include <ranges>
+#include <unordered_set>
+
+ProcessTree::ProcessTree()
+{
+    nodes.emplace(ROOT, Node {});
+}
+
+bool ProcessTree::is_descendant(ProcessId pid, ProcessId ancestor) const
+{
+    return find_ancestor(pid, [ancestor] (ProcessId candidate, std::string const&) { return candidate == ancestor; }).has_value();
+}
+
+void ProcessTree::link(ProcessId pid, Node& node)
+{
+    auto const parentPid = node.reportedParent;
+
+    // linking under one of its own descendants would cut the subtree off from ROOT.
+    auto const linked = parentPid != pid && contains(parentPid) && !is_descendant(parentPid, pid);
+    node.parent = linked ? parentPid : ROOT;
+
+    auto& siblings = nodes.at(node.parent).children;
+    node.siblingIndex = static_cast<std::uint32_t>(siblings.size());
+    siblings.push_back(pid);
+}
+
+void ProcessTree::unlink(Node& node)
+{
+    auto& siblings = nodes.at(node.parent).children;
+    auto const last = siblings.back();
+
+    siblings[node.siblingIndex] = last;
+    nodes.at(last).siblingIndex = node.siblingIndex;
+    siblings.pop_back();
+}
+
+void ProcessTree::insert(ProcessId pid, ProcessId parentPid, std::string const& name)
+{
+    if (pid == ROOT) return;
+
+    erase(pid);
+
+    auto& node = nodes.emplace(pid, Node { .reportedParent = parentPid, .name = name }).first->second;
+    link(pid, node);
+
+    changes += 1;
+}
+
+void ProcessTree::erase(ProcessId pid)
+{
+    auto const found = nodes.find(pid);
+    if (pid == ROOT || found == nodes.end()) return;
+
+    auto& node = found->second;
+    unlink(node);
+
+    // the reported parent is forgotten too, so the orphans don't end up under whoever reuses the pid.
+    for (auto const child : node.children)
+    {
+        auto& childNode = nodes.at(child);
+        childNode.reportedParent = ROOT;
+        childNode.orphaned = true;
+        link(child, childNode);
+    }
+
+    nodes.erase(found);
+
+    changes += 1;
+}
+
+void ProcessTree::rename(ProcessId pid, std::string const& name)
+{
+    auto const found = nodes.find(pid);
+    if (pid == ROOT || found == nodes.end() || found->second.name == name) return;
+
+    found->second.name = name;
+
+    changes += 1;
+}
+
+void ProcessTree::reconcile(ProcessTable const& processes)
+{
+    ProcessTreeChanges changed {};
+    reconcile(processes, changed);
+}
+
+void ProcessTree::reconcile(ProcessTable const& processes, ProcessTreeChanges& changed)
+{
+    std::unordered_set<ProcessId> seen {};
+    seen.reserve(nodes.size());
+
+    for (auto const& process : processes | std::views::values | std::views::join)
+    {
+        seen.insert(process.pid);
+
+        auto const found = nodes.find(process.pid);
+
+        if (found == nodes.end() || found->second.name != process.name)
+        {
+            if (found != nodes.end()) changed.exited.emplace_back(found->second.name, process.pid);
+            insert(process.pid, process.parentPid, process.name);
+            changed.started.push_back(process);
+        }
+        else if (!found->second.orphaned && found->second.reportedParent != process.parentPid)
+        {
+            unlink(found->second);
+            found->second.reportedParent = process.parentPid;
+            link(process.pid, found->second);
+            changed.moved.push_back(process.pid);
+            changes += 1;
+        }
+    }
+
+    scratch.clear();
+    for (auto const& pid : nodes | std::views::keys)
+    {
+        if (pid != ROOT && !seen.contains(pid)) scratch.push_back(pid);
+    }
+
+    for (auto const pid : scratch)
+    {
+        changed.exited.emplace_back(nodes.at(pid).name, pid);
+        erase(pid);
+    }
+
+    // a scan lists children and parents in no particular order, the ones seen before their parent get linked now.
+    scratch.assign(nodes.at(ROOT).children.begin(), nodes.at(ROOT).children.end());
+    for (auto const pid : scratch)
+    {
+        auto& node = nodes.at(pid);
+        if (!contains(node.reportedParent)) continue;
+        unlink(node);
+        link(pid, node);
+        if (node.parent == ROOT) continue;
+        changed.moved.push_back(pid);
+        changes += 1;
+    }
+}
+
+std::span<ProcessId const> ProcessTree::children(ProcessId pid) const
+{
+    auto const node = nodes.find(pid);
+    if (node == nodes.end()) return {};
+    return node->second.children;
+}
+
+std::string const& ProcessTree::name(ProcessId pid) const
+{
+    return nodes.at(pid).name;
+}
@@ -0,0 +1,138 @@
+#include "os/process/ProcessUsageSampler.hpp"
+
+ProcessUsageSampler::ProcessUsageSampler(ProcessSourceBackend const& processSource, std::chrono::milliseconds sampleInterval)
+    : source(processSource)
+    , interval(sampleInterval)
+{
+    sampler = std::jthread([this] (std::stop_token stopToken) { run(std::move(stopToken)); });
+}
+
+bool ProcessUsageSampler::request(std::span<ProcessId const> pids)
+{
+    std::unique_lock lock { requestMutex, std::try_to_lock };
+    if (!lock.owns_lock()) return false;
+
+    requested.assign(pids.begin(), pids.end());
+
+    return true;
+}
+
+bool ProcessUsageSampler::copy_to(ProcessUsageSnapshot& snapshot)
+{
+    std::unique_lock lock { snapshotMutex, std::try_to_lock };
+    if (!lock.owns_lock()) return false;
+
+    snapshot.samples.assign(latest.samples.begin(), latest.samples.end());
+    snapshot.slots = latest.slots;
+
+    return true;
+}
+
+void ProcessUsageSampler::stop()
+{
+    sampler.request_stop();
+    if (sampler.joinable()) sampler.join();
+}
+
+void ProcessUsageSampler::run(std::stop_token stopToken)
+{
+    while (!stopToken.stop_requested())
+    {
+        sample_round();
+
+        std::unique_lock lock { sleepMutex };
+        sleeper.wait_for(lock, stopToken, interval, [] { return false; });
+    }
+}
+
+void ProcessUsageSampler::sample_round()
+{
+    {
+        std::scoped_lock lock { requestMutex };
+        wanted.assign(requested.begin(), requested.end());
+    }
+
+    round += 1;
+
+    auto const fnReleaseSlot = [&] (std::uint32_t slot) {
+        current.slots.erase(current.samples[slot].pid);
+        current.samples[slot] = {};
+        freeSlots.push_back(slot);
+    };
+
+    for (auto const pid : wanted)
+    {
+        if (pid == ProcessId {}) continue;
+
+        auto slot = ProcessUsageSnapshot::NO_SLOT;
+
+        if (auto const found = current.slots.find(pid); found != current.slots.end())
+        {
+            slot = found->second;
+            // the same pid was asked for twice in one request.
+            if (slotRounds[slot] == round) continue;
+        }
+
+        // the process may have exited since it was requested, it simply gets no sample then.
+        auto const usage = source.usage(pid);
+        if (!usage)
+        {
+            if (slot != ProcessUsageSnapshot::NO_SLOT) fnReleaseSlot(slot);
+            continue;
+        }
+
+        if (slot == ProcessUsageSnapshot::NO_SLOT)
+        {
+            if (freeSlots.empty())
+            {
+                slot = static_cast<std::uint32_t>(current.samples.size());
+                current.samples.emplace_back();
+                slotRounds.push_back(0);
+            }
+            else
+            {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+
+            current.slots.emplace(pid, slot);
+        }
+
+        auto& sample = current.samples[slot];
+        auto const now = std::chrono::steady_clock::now();
+
+        // a pid whose CPU time went backwards was reused by a new process since the last round.
+        if (sample.pid == pid && usage->cpuTime >= sample.cpuTime && now > sample.sampledAt)
+        {
+            std::chrono::duration<float> const busy = usage->cpuTime - sample.cpuTime;
+            std::chrono::duration<float> const elapsed = now - sample.sampledAt;
+            sample.cpuPercent = busy.count() / elapsed.count() * 100.0f;
+            sample.hasRate = true;
+        }
+        else
+        {
+            sample.cpuPercent = 0.0f;
+            sample.hasRate = false;
+        }
+
+        sample.pid = pid;
+        sample.cpuTime = usage->cpuTime;
+        sample.sampledAt = now;
+        sample.residentBytes = usage->residentBytes;
+        slotRounds[slot] = round;
+    }
+
+    // whatever wasn't asked for this round gives its slot back.
+    for (auto slot = 0u; slot < current.samples.size(); slot += 1)
+    {
+        if (current.samples[slot].pid != ProcessId {} && slotRounds[slot] != round) fnReleaseSlot(slot);
+    }
+
+    {
+        std::scoped_lock lock { snapshotMutex };
+        latest.samples.assign(current.samples.begin(), current.samples.end());
+        latest.slots = current.slots;
+    }
+
+    published.fetch_add(1, std::memory_order_release);
+}
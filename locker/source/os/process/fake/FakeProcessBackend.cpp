@@ -0,0 +1,286 @@
+#include "os/process/fake/FakeProcessBackend.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace liberror;
+
+FakeProcessWorld& fake_process_world()
+{
+    static FakeProcessWorld world {};
+    return world;
+}
+
+void FakeProcessWorld::apply(std::span<FakeProcessAction const> actions, std::span<std::string const> names)
+{
+    // the engine takes the world's lock to track what it's told about, so the events wait until the batch is done with it.
+    thread_local std::vector<ProcessEvent> events {};
+    ProcessEventQueue* target {};
+
+    events.clear();
+
+    {
+        std::scoped_lock lock { mutex };
+        target = queue;
+
+        for (auto const& action : actions)
+        {
+            if (action.kind == ProcessEvent::Kind::CREATED)
+            {
+                auto const& process = processes.insert_or_assign(action.pid, FakeProcess { ProcessInfo { names[action.program], action.pid, action.parentPid }, nextIncarnation++ }).first->second.info;
+                if (target != nullptr) events.emplace_back(ProcessEvent::Kind::CREATED, process.pid, process.name, process.parentPid);
+            }
+            else if (action.kind == ProcessEvent::Kind::REPLACED)
+            {
+                // an exec, the same process and incarnation with another program.
+                auto const process = processes.find(action.pid);
+                if (process == processes.end()) continue;
+                process->second.info.name = names[action.program];
+                if (target != nullptr) events.emplace_back(ProcessEvent::Kind::REPLACED, action.pid, process->second.info.name, process->second.info.parentPid);
+            }
+            else if (auto process = processes.extract(action.pid); !process.empty())
+            {
+                if (target != nullptr) events.emplace_back(ProcessEvent::Kind::DELETED, action.pid, process.mapped().info.name);
+            }
+        }
+    }
+
+    for (auto const& event : events)
+    {
+        target->push(event);
+    }
+}
+
+std::optional<FakeProcessWorld::Incarnation> FakeProcessWorld::incarnation_of(ProcessId pid) const
+{
+    std::scoped_lock lock { mutex };
+    auto const process = processes.find(pid);
+    if (process == processes.end()) return std::nullopt;
+    return process->second.incarnation;
+}
+
+bool FakeProcessWorld::is_alive(ProcessId pid, Incarnation incarnation) const
+{
+    std::scoped_lock lock { mutex };
+    auto const process = processes.find(pid);
+    return process != processes.end() && process->second.incarnation == incarnation;
+}
+
+bool FakeProcessWorld::is_suspended(ProcessId pid) const
+{
+    std::scoped_lock lock { mutex };
+    auto const process = processes.find(pid);
+    return process != processes.end() && process->second.info.suspended;
+}
+
+Result<ProcessUsage> FakeProcessWorld::usage(ProcessId pid) const
+{
+    {
+        std::scoped_lock lock { mutex };
+        if (!processes.contains(pid)) return make_error("process {} doesn't exist", pid);
+    }
+
+    // every pid gets a fixed share of a core and a fixed resident size, so runs stay reproducible.
+    auto const hash = static_cast<std::uint64_t>(pid) * 0x9E3779B97F4A7C15ull;
+    auto const load = (hash >> 56) % 100 + 1;
+    auto const uptime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - createdAt);
+
+    return ProcessUsage {
+        .cpuTime = uptime * static_cast<std::int64_t>(load) / 100,
+        .residentBytes = ((hash >> 32) % 512 + 1) * 1024 * 1024,
+    };
+}
+
+Result<void> FakeProcessWorld::set_suspended(ProcessId pid, std::optional<Incarnation> incarnation, bool suspended)
+{
+    std::scoped_lock lock { mutex };
+
+    auto const process = processes.find(pid);
+    if (process == processes.end() || (incarnation && process->second.incarnation != *incarnation))
+    {
+        return make_error("process {} doesn't exist", pid);
+    }
+
+    process->second.info.suspended = suspended;
+
+    return {};
+}
+
+void FakeProcessWorld::attach(ProcessEventQueue* eventQueue)
+{
+    std::scoped_lock lock { mutex };
+    queue = eventQueue;
+}
+
+ProcessTable FakeProcessWorld::snapshot() const
+{
+    std::scoped_lock lock { mutex };
+
+    ProcessTable table {};
+    for (auto const& [pid, process] : processes)
+    {
+        table[process.info.name].emplace_back(process.info.name, pid, process.info.parentPid);
+    }
+
+    return table;
+}
+
+Result<void> FakeProcessSource::start(ProcessEventQueue& queue)
+{
+    FakeProcessWorkload workload {};
+
+    if (auto const* text = std::getenv("LOCKER_FAKE_WORKLOAD"))
+    {
+        workload = TRY(parse_fake_process_workload(text));
+    }
+
+    generator.emplace(workload);
+
+    // the initial population is already running by the time anyone looks, so it goes in before the queue is attached.
+    std::vector<FakeProcessAction> actions {};
+    generator->populate(actions);
+    fake_process_world().apply(actions, generator->program_names());
+
+    fake_process_world().attach(&queue);
+    player = std::jthread([this] (std::stop_token stopToken) { replay(stopToken); });
+
+    return {};
+}
+
+void FakeProcessSource::stop()
+{
+    if (player.joinable())
+    {
+        player.request_stop();
+        player.join();
+        spdlog::info("Fake process backend replayed {} events", generator->generated_events());
+    }
+
+    fake_process_world().attach(nullptr);
+}
+
+void FakeProcessSource::replay(std::stop_token stopToken)
+{
+    // small enough batches that a slow workload still trickles in at roughly its own pace.
+    constexpr auto BATCH_DURATION = std::chrono::milliseconds(10);
+    constexpr std::size_t MAX_BATCH_SIZE = 4096;
+
+    auto const rate = generator->arrival_rate();
+    auto const batchSize = rate > 0 ? std::clamp<std::size_t>(static_cast<std::size_t>(rate * std::chrono::duration<double>(BATCH_DURATION).count()), 1, MAX_BATCH_SIZE) : MAX_BATCH_SIZE;
+    auto const startTime = std::chrono::steady_clock::now();
+
+    std::vector<FakeProcessAction> actions {};
+    actions.reserve(batchSize);
+
+    while (!stopToken.stop_requested() && !generator->exhausted())
+    {
+        actions.clear();
+        generator->generate(actions, batchSize);
+        if (actions.empty()) break;
+
+        if (rate > 0)
+        {
+            std::unique_lock lock { mutex };
+            sleeper.wait_until(lock, stopToken, startTime + actions.back().at, [] { return false; });
+        }
+
+        fake_process_world().apply(actions, generator->program_names());
+    }
+
+    replayed.store(generator->exhausted(), std::memory_order_release);
+}
+
+Result<ProcessTable> FakeProcessSource::scan()
+{
+    return fake_process_world().snapshot();
+}
+
+Result<ProcessUsage> FakeProcessSource::usage(ProcessId pid) const
+{
+    return fake_process_world().usage(pid);
+}
+
+//
+// What a tracked ProcessInfo holds on to. Every operation checks the
+// incarnation, so once the pid is reused the handle reports its process as
+// exited instead of acting on the newcomer.
+//
+struct FakeProcessHandle
+{
+    ProcessId pid;
+    FakeProcessWorld::Incarnation incarnation;
+};
+
+static FakeProcessHandle const* fake_handle_of(ProcessInfo const& process)
+{
+    return static_cast<FakeProcessHandle const*>(process.handle.get());
+}
+
+Result<void> FakeProcessController::track(ProcessInfo& process)
+{
+    auto const incarnation = fake_process_world().incarnation_of(process.pid);
+    if (!incarnation)
+    {
+        return make_error("process {} doesn't exist", process.pid);
+    }
+
+    // a handle left over from an earlier process with the same pid is replaced, not shared.
+    auto& handle = processHandles[process.pid];
+    if (handle == nullptr || static_cast<FakeProcessHandle const*>(handle.get())->incarnation != *incarnation)
+    {
+        handle = std::make_shared<FakeProcessHandle>(process.pid, *incarnation);
+    }
+
+    process.handle = handle;
+
+    return {};
+}
+
+bool FakeProcessController::has_exited(ProcessInfo const& process) const
+{
+    auto const* handle = fake_handle_of(process);
+    if (handle == nullptr) return false;
+    return !fake_process_world().is_alive(handle->pid, handle->incarnation);
+}
+
+static Result<void> set_suspended(ProcessInfo const& process, bool suspended)
+{
+    if (auto const* handle = fake_handle_of(process))
+    {
+        return fake_process_world().set_suspended(handle->pid, handle->incarnation, suspended);
+    }
+
+    return fake_process_world().set_suspended(process.pid, std::nullopt, suspended);
+}
+
+std::vector<ProcessOperationResult> FakeProcessController::suspend(std::span<ProcessInfo const> processes)
+{
+    std::vector<ProcessOperationResult> results {};
+    results.reserve(processes.size());
+
+    // the simulated process stops the moment it is told to, so the call returning is the confirmation.
+    for (auto const& process : processes)
+    {
+        auto const issued = std::chrono::steady_clock::now();
+        auto result = set_suspended(process, true);
+        results.emplace_back(process.pid, std::move(result), issued, std::chrono::steady_clock::now());
+    }
+
+    return results;
+}
+
+std::vector<ProcessOperationResult> FakeProcessController::resume(std::span<ProcessInfo const> processes)
+{
+    std::vector<ProcessOperationResult> results {};
+    results.reserve(processes.size());
+
+    for (auto const& process : processes)
+    {
+        results.emplace_back(process.pid, set_suspended(process, false));
+    }
+
+    return results;
+}
@@ -0,0 +1,165 @@
+#include "os/process/fake/FakeProcessGenerator.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <charconv>
+#include <ranges>
+
+using namespace liberror;
+
+template <class T>
+static Result<T> parse_number(std::string_view key, std::string_view value)
+{
+    T number {};
+    auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+
+    if (error != std::errc {} || end != value.data() + value.size())
+    {
+        return make_error("invalid value for {}: {}", key, value);
+    }
+
+    return number;
+}
+
+Result<FakeProcessWorkload> parse_fake_process_workload(std::string_view text)
+{
+    FakeProcessWorkload workload {};
+
+    for (auto const field : text | std::views::split(','))
+    {
+        std::string_view const pair { field.begin(), field.end() };
+        if (pair.empty()) continue;
+
+        auto const separator = pair.find('=');
+        if (separator == std::string_view::npos)
+        {
+            return make_error("expected key=value, got: {}", pair);
+        }
+
+        auto const key = pair.substr(0, separator);
+        auto const value = pair.substr(separator + 1);
+
+        if (key == "seed") workload.seed = TRY(parse_number<std::uint64_t>(key, value));
+        else if (key == "rate") workload.arrivalRate = TRY(parse_number<double>(key, value));
+        else if (key == "population") workload.population = TRY(parse_number<std::size_t>(key, value));
+        else if (key == "programs") workload.programs = TRY(parse_number<std::size_t>(key, value));
+        else if (key == "burst") workload.burstProbability = TRY(parse_number<double>(key, value));
+        else if (key == "burst_size") workload.burstSize = TRY(parse_number<std::size_t>(key, value));
+        else if (key == "pid_limit") workload.pidLimit = TRY(parse_number<ProcessId>(key, value));
+        else if (key == "events") workload.events = TRY(parse_number<std::uint64_t>(key, value));
+        else return make_error("unknown workload key: {}", key);
+    }
+
+    if (workload.programs == 0 || workload.pidLimit < 2)
+    {
+        return make_error("a workload needs at least one program and two pids");
+    }
+
+    return workload;
+}
+
+FakeProcessGenerator::FakeProcessGenerator(FakeProcessWorkload const& fakeWorkload)
+    : workload(fakeWorkload)
+    , random(fakeWorkload.seed)
+    , arrivals(fakeWorkload.arrivalRate > 0 ? fakeWorkload.arrivalRate / 1e9 : 1.0)
+{
+    names.reserve(workload.programs);
+    for (std::size_t program = 0; program < workload.programs; program += 1)
+    {
+        names.push_back(fmt::format("program-{}", program));
+    }
+
+    live.reserve(workload.population);
+    liveIndex.assign(workload.pidLimit, NOT_LIVE);
+}
+
+ProcessId FakeProcessGenerator::allocate_pid()
+{
+    // like the kernel: hand out pids in increasing order, wrap at the limit and skip whatever is still alive.
+    while (liveIndex[nextPid] != NOT_LIVE)
+    {
+        nextPid = nextPid + 1 == workload.pidLimit ? 1 : nextPid + 1;
+    }
+
+    auto const pid = nextPid;
+    nextPid = nextPid + 1 == workload.pidLimit ? 1 : nextPid + 1;
+
+    return pid;
+}
+
+ProcessId FakeProcessGenerator::pick_parent()
+{
+    if (live.empty()) return 0;
+    return live[std::uniform_int_distribution<std::size_t> { 0, live.size() - 1 }(random)];
+}
+
+void FakeProcessGenerator::create(std::vector<FakeProcessAction>& actions, ProcessId parentPid)
+{
+    auto const pid = allocate_pid();
+    auto const program = std::uniform_int_distribution<std::uint32_t> { 0, static_cast<std::uint32_t>(names.size() - 1) }(random);
+
+    liveIndex[pid] = static_cast<std::uint32_t>(live.size());
+    live.push_back(pid);
+    actions.push_back({ ProcessEvent::Kind::CREATED, pid, parentPid, program, now });
+}
+
+void FakeProcessGenerator::exit(std::vector<FakeProcessAction>& actions)
+{
+    auto const index = std::uniform_int_distribution<std::size_t> { 0, live.size() - 1 }(random);
+    auto const pid = live[index];
+
+    // swap-remove, so picking a victim stays O(1) at any population.
+    liveIndex[live.back()] = static_cast<std::uint32_t>(index);
+    live[index] = live.back();
+    live.pop_back();
+    liveIndex[pid] = NOT_LIVE;
+
+    actions.push_back({ ProcessEvent::Kind::DELETED, pid, 0, 0, now });
+}
+
+void FakeProcessGenerator::populate(std::vector<FakeProcessAction>& actions)
+{
+    auto const population = std::min<std::size_t>(workload.population, workload.pidLimit - 1);
+
+    while (live.size() < population)
+    {
+        create(actions, pick_parent());
+    }
+}
+
+void FakeProcessGenerator::generate(std::vector<FakeProcessAction>& actions, std::size_t count)
+{
+    auto const full = static_cast<std::size_t>(workload.pidLimit - 1);
+
+    auto const end = actions.size() + count;
+
+    while (actions.size() < end && !exhausted())
+    {
+        auto const before = actions.size();
+
+        if (workload.arrivalRate > 0)
+        {
+            now += std::chrono::nanoseconds(static_cast<std::int64_t>(arrivals(random)));
+        }
+
+        // the further above the target population, the likelier the next event is an exit.
+        auto const exitProbability = static_cast<double>(live.size()) / static_cast<double>(live.size() + std::max<std::size_t>(workload.population, 1));
+
+        if (live.size() == full || (!live.empty() && std::bernoulli_distribution { exitProbability }(random)))
+        {
+            exit(actions);
+        }
+        else
+        {
+            auto const burst = std::bernoulli_distribution { workload.burstProbability }(random) ? workload.burstSize : 1;
+            auto const parentPid = pick_parent();
+            for (std::size_t spawned = 0; spawned < burst && live.size() < full; spawned += 1)
+            {
+                create(actions, parentPid);
+            }
+        }
+
+        generated += actions.size() - before;
+    }
+}
@@ -0,0 +1,623 @@
+#include "os/process/linux/LinuxProcessBackend.hpp"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace liberror;
+
+// reads /proc/<pid>/<entry> into the buffer in a single read, which is all these small files need.
+static std::optional<std::string_view> read_process_file(ProcessId pid, std::string_view entry, std::span<char> buffer)
+{
+    std::array<char, 48> path {};
+
+    *fmt::format_to_n(path.data(), path.size() - 1, "/proc/{}/{}", pid, entry).out = '\0';
+
+    auto file = open(path.data(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) return std::nullopt;
+
+    auto const bytes = read(file, buffer.data(), buffer.size());
+    close(file);
+    if (bytes <= 0) return std::nullopt;
+
+    return std::string_view { buffer.data(), static_cast<std::size_t>(bytes) };
+}
+
+static std::optional<std::string> read_process_name(ProcessId pid)
+{
+    std::array<char, 64> comm {};
+
+    auto name = read_process_file(pid, "comm", comm);
+    if (!name) return std::nullopt;
+    if (name->ends_with('\n')) name->remove_suffix(1);
+
+    return std::string(*name);
+}
+
+template <class Number>
+static std::optional<Number> parse_field(std::string_view& fields)
+{
+    auto const start = fields.find_first_not_of(' ');
+    if (start == std::string_view::npos) return std::nullopt;
+    fields.remove_prefix(start);
+
+    Number value {};
+    auto const [end, error] = std::from_chars(fields.data(), fields.data() + fields.size(), value);
+    if (error != std::errc {}) return std::nullopt;
+    fields.remove_prefix(static_cast<std::size_t>(end - fields.data()));
+
+    return value;
+}
+
+static void for_each_pid(auto&& fnVisitPid)
+{
+    auto* directory = opendir("/proc");
+    if (directory == nullptr) return;
+
+    while (auto* entry = readdir(directory))
+    {
+        std::string_view const name { entry->d_name };
+        ProcessId pid = 0;
+        auto const [end, error] = std::from_chars(name.data(), name.data() + name.size(), pid);
+        if (error != std::errc {} || end != name.data() + name.size()) continue;
+        fnVisitPid(pid);
+    }
+
+    closedir(directory);
+}
+
+struct ProcessStat
+{
+    std::string name;
+    char state;
+    ProcessId parentPid;
+};
+
+// /proc/<pid>/stat starts with the pid, the name in parentheses, which may itself hold spaces and parentheses, the state letter and the parent.
+static std::optional<ProcessStat> read_process_stat(ProcessId pid)
+{
+    std::array<char, 512> buffer {};
+
+    auto stat = read_process_file(pid, "stat", buffer);
+    if (!stat) return std::nullopt;
+
+    auto const nameStart = stat->find('(');
+    auto const nameEnd = stat->rfind(')');
+    if (nameStart == std::string_view::npos || nameEnd == std::string_view::npos || nameEnd < nameStart || nameEnd + 4 > stat->size()) return std::nullopt;
+
+    std::string name { stat->substr(nameStart + 1, nameEnd - nameStart - 1) };
+    auto const state = (*stat)[nameEnd + 2];
+    stat->remove_prefix(nameEnd + 4);
+
+    auto const parentPid = parse_field<ProcessId>(*stat);
+    if (!parentPid) return std::nullopt;
+
+    return ProcessStat { std::move(name), state, *parentPid };
+}
+
+static ProcessId read_parent_pid(ProcessId pid)
+{
+    return read_process_stat(pid).transform([] (ProcessStat const& stat) { return stat.parentPid; }).value_or(0);
+}
+
+Result<ProcessTable> LinuxProcessSource::scan()
+{
+    ProcessTable processes {};
+
+    for_each_pid([&] (ProcessId pid) {
+        auto name = read_process_name(pid);
+        if (!name) return;
+        processes[*name].emplace_back(*name, pid, read_parent_pid(pid));
+    });
+
+    return processes;
+}
+
+Result<ProcessUsage> LinuxProcessSource::usage(ProcessId pid) const
+{
+    static auto const CLOCK_TICKS = static_cast<std::uint64_t>(sysconf(_SC_CLK_TCK));
+    static auto const PAGE_SIZE = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+
+    std::array<char, 512> buffer {};
+
+    auto stat = read_process_file(pid, "stat", buffer);
+    if (!stat) return make_error("couldn't read /proc/{}/stat", pid);
+
+    // the command name sits in parentheses and may contain spaces, the fields are counted from the last ')'.
+    // utime and stime are the 14th and 15th fields, so 11 fields after the state letter at the 3rd.
+    auto const nameEnd = stat->rfind(')');
+    if (nameEnd == std::string_view::npos || nameEnd + 4 > stat->size()) return make_error("malformed /proc/{}/stat", pid);
+    stat->remove_prefix(nameEnd + 4);
+
+    for (auto field = 0; field < 10; field += 1)
+    {
+        if (!parse_field<std::int64_t>(*stat)) return make_error("malformed /proc/{}/stat", pid);
+    }
+
+    auto const userTicks = parse_field<std::uint64_t>(*stat);
+    auto const systemTicks = parse_field<std::uint64_t>(*stat);
+    if (!userTicks || !systemTicks) return make_error("malformed /proc/{}/stat", pid);
+
+    auto statm = read_process_file(pid, "statm", buffer);
+    if (!statm) return make_error("couldn't read /proc/{}/statm", pid);
+
+    [[maybe_unused]] auto const totalPages = parse_field<std::uint64_t>(*statm);
+    auto const residentPages = parse_field<std::uint64_t>(*statm);
+    if (!residentPages) return make_error("malformed /proc/{}/statm", pid);
+
+    auto const ticks = *userTicks + *systemTicks;
+
+    return ProcessUsage {
+        .cpuTime = std::chrono::nanoseconds { static_cast<std::int64_t>(ticks * 1'000'000'000 / CLOCK_TICKS) },
+        .residentBytes = *residentPages * PAGE_SIZE,
+    };
+}
+
+// the exit events go out before a process turns into a zombie, so a resync in between still finds it running; another a moment later catches it.
+static constexpr auto FOLLOW_UP_RESYNC_DELAY = std::chrono::milliseconds(250);
+
+// how long poll may wait before a follow-up resync is due, forever when none is pending.
+static int follow_up_resync_timeout(std::optional<std::chrono::steady_clock::time_point> followUpResyncAt)
+{
+    if (!followUpResyncAt) return -1;
+    auto const remaining = std::chrono::ceil<std::chrono::milliseconds>(*followUpResyncAt - std::chrono::steady_clock::now());
+    return static_cast<int>(std::max<std::chrono::milliseconds::rep>(remaining.count(), 0));
+}
+
+// the NLMSG_* macros are built on C casts, this is the same arithmetic without them.
+static constexpr std::size_t netlink_align(std::size_t length)
+{
+    return (length + NLMSG_ALIGNTO - 1) & ~std::size_t { NLMSG_ALIGNTO - 1 };
+}
+
+static constexpr auto NETLINK_HEADER_SIZE = netlink_align(sizeof(nlmsghdr));
+
+static void* netlink_data(nlmsghdr* header)
+{
+    return reinterpret_cast<char*>(header) + NETLINK_HEADER_SIZE;
+}
+
+static Result<int> connect_to_process_connector()
+{
+    auto connector = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (connector < 0)
+    {
+        return make_error("socket failed with: {}", std::strerror(errno));
+    }
+
+    sockaddr_nl address {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = CN_IDX_PROC;
+
+    // a burst of exits outruns the default buffer after a few hundred messages; forcing it past rmem_max takes the same CAP_NET_ADMIN the connector does.
+    constexpr int RECEIVE_BUFFER_SIZE = 8 << 20;
+    if (setsockopt(connector, SOL_SOCKET, SO_RCVBUFFORCE, &RECEIVE_BUFFER_SIZE, sizeof(RECEIVE_BUFFER_SIZE)) != 0)
+    {
+        setsockopt(connector, SOL_SOCKET, SO_RCVBUF, &RECEIVE_BUFFER_SIZE, sizeof(RECEIVE_BUFFER_SIZE));
+    }
+
+    if (bind(connector, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(connector);
+        return make_error("bind failed with: {}", std::strerror(errno));
+    }
+
+    // cn_msg ends in a flexible array, so the request is laid out by hand.
+    constexpr auto REQUEST_SIZE = NETLINK_HEADER_SIZE + sizeof(cn_msg) + sizeof(proc_cn_mcast_op);
+    alignas(nlmsghdr) std::array<char, netlink_align(REQUEST_SIZE)> request {};
+
+    auto* header = reinterpret_cast<nlmsghdr*>(request.data());
+    header->nlmsg_len = static_cast<__u32>(REQUEST_SIZE);
+    header->nlmsg_type = NLMSG_DONE;
+    header->nlmsg_pid = static_cast<__u32>(getpid());
+
+    auto* message = static_cast<cn_msg*>(netlink_data(header));
+    message->id.idx = CN_IDX_PROC;
+    message->id.val = CN_VAL_PROC;
+    message->len = sizeof(proc_cn_mcast_op);
+
+    auto const operation = PROC_CN_MCAST_LISTEN;
+    std::memcpy(message->data, &operation, sizeof(operation));
+
+    if (send(connector, request.data(), REQUEST_SIZE, 0) < 0)
+    {
+        close(connector);
+        return make_error("send failed with: {}", std::strerror(errno));
+    }
+
+    return connector;
+}
+
+Result<void> LinuxProcessSource::start(ProcessEventQueue& queue)
+{
+    // exit events only carry the pid, so the names have to be known up front.
+    for (auto const& [name, processes] : TRY(scan()))
+    {
+        for (auto const& process : processes) names.emplace(process.pid, name);
+    }
+
+    // the tracepoints need CAP_BPF and CAP_PERFMON, without them the same events come from the process connector instead.
+    if (auto subscription = subscribe_to_process_trace_events(); subscription)
+    {
+        traceSubscription = std::move(subscription).value();
+        listener = std::jthread([this, &queue] (std::stop_token stopToken) { listen_to_trace(queue, stopToken); });
+        return {};
+    }
+    else
+    {
+        spdlog::warn("Falling back to the process connector for process events: {}", subscription.error().message());
+    }
+
+    if (auto result = connect_to_process_connector(); result)
+    {
+        connector = result.value();
+        listener = std::jthread([this, &queue] (std::stop_token stopToken) { listen_to_connector(queue, stopToken); });
+        return {};
+    }
+    else
+    {
+        spdlog::warn("Falling back to polling /proc for process events: {}", result.error().message());
+    }
+
+    listener = std::jthread([this, &queue] (std::stop_token stopToken) { poll_procfs(queue, stopToken); });
+
+    return {};
+}
+
+void LinuxProcessSource::stop()
+{
+    if (listener.joinable())
+    {
+        listener.request_stop();
+        stopSignal.raise();
+        listener.join();
+    }
+
+    if (traceSubscription) unsubscribe_from_process_trace_events(*traceSubscription);
+    traceSubscription.reset();
+
+    if (connector >= 0) close(connector);
+    connector = -1;
+}
+
+void LinuxProcessSource::listen_to_trace(ProcessEventQueue& queue, std::stop_token stopToken)
+{
+    std::vector<ProcessTraceRecord> records {};
+    std::array<pollfd, 2> descriptors {{ { traceSubscription->ring, POLLIN, 0 }, { stopSignal.handle(), POLLIN, 0 } }};
+    std::optional<std::chrono::steady_clock::time_point> followUpResyncAt {};
+
+    while (!stopToken.stop_requested())
+    {
+        auto const ready = poll(descriptors.data(), descriptors.size(), follow_up_resync_timeout(followUpResyncAt));
+        if (ready < 0 && errno != EINTR) return;
+
+        if (followUpResyncAt && std::chrono::steady_clock::now() >= *followUpResyncAt)
+        {
+            resync(queue);
+            followUpResyncAt.reset();
+        }
+
+        if (ready < 0 || !(descriptors[0].revents & POLLIN)) continue;
+
+        records.clear();
+        auto const dropped = read_process_trace_events(*traceSubscription, records);
+
+        for (auto const& record : records)
+        {
+            std::string name { record.name.data(), ::strnlen(record.name.data(), record.name.size()) };
+
+            switch (record.kind)
+            {
+            case ProcessTraceRecord::Kind::FORK: on_fork(queue, record.pid, record.parentPid, std::move(name)); break;
+            case ProcessTraceRecord::Kind::EXEC: on_exec(queue, record.pid, std::move(name)); break;
+            case ProcessTraceRecord::Kind::EXIT: on_exit(queue, record.pid); break;
+            }
+        }
+
+        // the ring filled up and the programs counted what didn't fit, only a full scan can tell what that was.
+        if (dropped > 0)
+        {
+            spdlog::warn("Process trace dropped {} events, resyncing from /proc", dropped);
+            resync(queue);
+            followUpResyncAt = std::chrono::steady_clock::now() + FOLLOW_UP_RESYNC_DELAY;
+        }
+    }
+}
+
+void LinuxProcessSource::listen_to_connector(ProcessEventQueue& queue, std::stop_token stopToken)
+{
+    alignas(nlmsghdr) std::array<char, 8192> buffer {};
+    std::array<pollfd, 2> descriptors {{ { connector, POLLIN, 0 }, { stopSignal.handle(), POLLIN, 0 } }};
+    std::optional<std::chrono::steady_clock::time_point> followUpResyncAt {};
+
+    while (!stopToken.stop_requested())
+    {
+        // revents is only filled in when poll reports something, after EINTR it still holds the last wakeup.
+        auto const ready = poll(descriptors.data(), descriptors.size(), follow_up_resync_timeout(followUpResyncAt));
+        if (ready < 0 && errno != EINTR) return;
+
+        if (followUpResyncAt && std::chrono::steady_clock::now() >= *followUpResyncAt)
+        {
+            resync(queue);
+            followUpResyncAt.reset();
+        }
+
+        if (ready < 0 || !(descriptors[0].revents & POLLIN)) continue;
+
+        auto const bytes = recv(connector, buffer.data(), buffer.size(), 0);
+
+        if (bytes < 0 && errno == ENOBUFS)
+        {
+            // the socket overflowed and the kernel dropped whatever didn't fit, only a full scan can tell what was missed.
+            spdlog::warn("Process connector dropped events, resyncing from /proc");
+            resync(queue);
+            followUpResyncAt = std::chrono::steady_clock::now() + FOLLOW_UP_RESYNC_DELAY;
+            continue;
+        }
+
+        if (bytes <= 0) continue;
+
+        auto const received = static_cast<std::size_t>(bytes);
+        for (std::size_t offset = 0; received - offset >= NETLINK_HEADER_SIZE;)
+        {
+            auto* header = reinterpret_cast<nlmsghdr*>(buffer.data() + offset);
+            if (header->nlmsg_len < NETLINK_HEADER_SIZE || header->nlmsg_len > received - offset) break;
+            offset += netlink_align(header->nlmsg_len);
+
+            auto const* message = static_cast<cn_msg const*>(netlink_data(header));
+            auto const* event = reinterpret_cast<proc_event const*>(message->data);
+
+            if (event->what == proc_event::PROC_EVENT_FORK)
+            {
+                // fork fires for new threads too, only a new thread group leader is a new process.
+                if (event->event_data.fork.child_pid != event->event_data.fork.child_tgid) continue;
+                auto const pid = static_cast<ProcessId>(event->event_data.fork.child_tgid);
+                if (auto name = read_process_name(pid)) on_fork(queue, pid, static_cast<ProcessId>(event->event_data.fork.parent_tgid), std::move(*name));
+            }
+            else if (event->what == proc_event::PROC_EVENT_EXEC)
+            {
+                auto const pid = static_cast<ProcessId>(event->event_data.exec.process_tgid);
+                if (auto name = read_process_name(pid)) on_exec(queue, pid, std::move(*name));
+            }
+            else if (event->what == proc_event::PROC_EVENT_EXIT)
+            {
+                // exit fires for every thread, only the thread group leader stands for the process.
+                if (event->event_data.exit.process_pid != event->event_data.exit.process_tgid) continue;
+                on_exit(queue, static_cast<ProcessId>(event->event_data.exit.process_tgid));
+            }
+        }
+    }
+}
+
+void LinuxProcessSource::on_fork(ProcessEventQueue& queue, ProcessId pid, ProcessId parentPid, std::string name)
+{
+    // a child that never execs still runs, and is locked along with a locked parent, so the fork is its creation.
+    queue.push({ ProcessEvent::Kind::CREATED, pid, name, parentPid });
+    names.insert_or_assign(pid, std::move(name));
+}
+
+void LinuxProcessSource::on_exec(ProcessEventQueue& queue, ProcessId pid, std::string name)
+{
+    // usually the fork was seen first, then the exec only changes what the process runs.
+    if (auto const known = names.find(pid); known != names.end())
+    {
+        if (known->second == name) return;
+        queue.push({ ProcessEvent::Kind::REPLACED, pid, name, read_parent_pid(pid) });
+        known->second = std::move(name);
+        return;
+    }
+
+    queue.push({ ProcessEvent::Kind::CREATED, pid, name, read_parent_pid(pid) });
+    names.emplace(pid, std::move(name));
+}
+
+void LinuxProcessSource::on_exit(ProcessEventQueue& queue, ProcessId pid)
+{
+    auto const name = names.extract(pid);
+    if (name.empty()) return;
+    queue.push({ ProcessEvent::Kind::DELETED, pid, name.mapped() });
+}
+
+void LinuxProcessSource::poll_procfs(ProcessEventQueue& queue, std::stop_token stopToken)
+{
+    constexpr auto POLL_INTERVAL_MS = 250;
+
+    pollfd descriptor { stopSignal.handle(), POLLIN, 0 };
+
+    while (!stopToken.stop_requested())
+    {
+        resync(queue);
+        poll(&descriptor, 1, POLL_INTERVAL_MS);
+    }
+}
+
+// diffs /proc against the known names and pushes an event for every process that came or went since.
+void LinuxProcessSource::resync(ProcessEventQueue& queue)
+{
+    resyncNames.clear();
+    for_each_pid([&] (ProcessId pid) {
+        // a zombie has exited already and its event went out, or was lost, with the exit; only its parent's wait keeps it listed.
+        auto stat = read_process_stat(pid);
+        if (!stat || stat->state == 'Z' || stat->state == 'X') return;
+
+        if (auto name = names.find(pid); name != names.end())
+        {
+            // an exec whose event was lost along with the rest.
+            if (name->second != stat->name) queue.push({ ProcessEvent::Kind::REPLACED, pid, stat->name, stat->parentPid });
+            resyncNames.emplace(pid, std::move(stat->name));
+            names.erase(name);
+        }
+        else
+        {
+            queue.push({ ProcessEvent::Kind::CREATED, pid, stat->name, stat->parentPid });
+            resyncNames.emplace(pid, std::move(stat->name));
+        }
+    });
+
+    // whatever is left over wasn't found in /proc anymore.
+    for (auto& [pid, name] : names)
+    {
+        queue.push({ ProcessEvent::Kind::DELETED, pid, name });
+    }
+
+    std::swap(names, resyncNames);
+}
+
+static int pidfd_of(ProcessInfo const& process)
+{
+    return process.handle == nullptr ? -1 : *static_cast<int const*>(process.handle.get());
+}
+
+Result<void> LinuxProcessController::track(ProcessInfo& process)
+{
+    if (auto handle = processHandles.find(process.pid); handle != processHandles.end())
+    {
+        process.handle = handle->second;
+        return {};
+    }
+
+    auto const pidfd = static_cast<int>(syscall(SYS_pidfd_open, process.pid, 0));
+    if (pidfd < 0)
+    {
+        return make_error("pidfd_open failed for process {} with: {}", process.pid, std::strerror(errno));
+    }
+
+    process.handle = ProcessHandle { new int(pidfd), [] (void* handle) {
+        close(*static_cast<int*>(handle));
+        delete static_cast<int*>(handle);
+    }};
+    processHandles.emplace(process.pid, process.handle);
+
+    return {};
+}
+
+bool LinuxProcessController::has_exited(ProcessInfo const& process) const
+{
+    auto const pidfd = pidfd_of(process);
+    if (pidfd < 0) return false;
+
+    // a pidfd turns readable once the process is gone.
+    pollfd descriptor { pidfd, POLLIN, 0 };
+    return poll(&descriptor, 1, 0) > 0;
+}
+
+static Result<void> send_signal(ProcessInfo const& process, int signal)
+{
+    // through the pidfd the signal can only ever reach the process we tracked, never a recycled pid.
+    if (auto const pidfd = pidfd_of(process); pidfd >= 0)
+    {
+        if (syscall(SYS_pidfd_send_signal, pidfd, signal, nullptr, 0) != 0)
+        {
+            return make_error("pidfd_send_signal failed for process {} with: {}", process.pid, std::strerror(errno));
+        }
+
+        return {};
+    }
+
+    if (kill(static_cast<pid_t>(process.pid), signal) != 0)
+    {
+        return make_error("kill failed for process {} with: {}", process.pid, std::strerror(errno));
+    }
+
+    return {};
+}
+
+//
+// A SIGSTOP only takes effect once the process next runs, so sending it is
+// not the same as the process having stopped. We aren't its parent, which
+// rules out waiting for the stop with waitid(), so /proc/<pid>/stat is polled
+// for the stopped state instead. The signals all go out first, so the batch
+// stops side by side rather than one process after the other. One that
+// doesn't stop in time, stuck in an uninterruptible wait say, is let go
+// again and reported as failed, so it is retried rather than left to stop
+// later on without us knowing.
+//
+static constexpr auto STOP_CONFIRMATION_TIMEOUT = std::chrono::milliseconds(100);
+static constexpr auto STOP_CONFIRMATION_INTERVAL = std::chrono::microseconds(50);
+
+std::vector<ProcessOperationResult> LinuxProcessController::suspend(std::span<ProcessInfo const> processes)
+{
+    std::vector<ProcessOperationResult> results {};
+    results.reserve(processes.size());
+
+    for (auto const& process : processes)
+    {
+        auto const issued = std::chrono::steady_clock::now();
+        results.emplace_back(process.pid, send_signal(process, SIGSTOP), issued);
+    }
+
+    auto const deadline = std::chrono::steady_clock::now() + STOP_CONFIRMATION_TIMEOUT;
+    auto const fnIsPending = [] (ProcessOperationResult const& result) {
+        return result.result && result.confirmed == std::chrono::steady_clock::time_point {};
+    };
+
+    while (std::ranges::any_of(results, fnIsPending))
+    {
+        for (auto& result : results | std::views::filter(fnIsPending))
+        {
+            auto const stat = read_process_stat(result.pid);
+
+            if (stat && (stat->state == 'T' || stat->state == 't'))
+            {
+                result.confirmed = std::chrono::steady_clock::now();
+            }
+            else if (!stat || stat->state == 'Z' || stat->state == 'X')
+            {
+                result.result = make_error("Process {} exited before it stopped", result.pid);
+            }
+        }
+
+        if (std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(STOP_CONFIRMATION_INTERVAL);
+            continue;
+        }
+
+        for (auto&& [process, result] : std::views::zip(processes, results))
+        {
+            if (!fnIsPending(result)) continue;
+
+            [[maybe_unused]] auto const resumed = send_signal(process, SIGCONT);
+            result.result = make_error("Process {} didn't stop within {}ms", result.pid, STOP_CONFIRMATION_TIMEOUT.count());
+        }
+    }
+
+    return results;
+}
+
+std::vector<ProcessOperationResult> LinuxProcessController::resume(std::span<ProcessInfo const> processes)
+{
+    std::vector<ProcessOperationResult> results {};
+    results.reserve(processes.size());
+
+    for (auto const& process : processes)
+    {
+        results.emplace_back(process.pid, send_signal(process, SIGCONT));
+    }
+
+    return results;
+}
@@ -0,0 +1,440 @@
+#include "os/process/linux/ProcessTrace.hpp"
+
+#include <fmt/format.h>
+
+#include <fcntl.h>
+#include <linux/bpf.h>
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+
+using namespace liberror;
+
+// a power of two number of pages, big enough for a fork storm of several thousand processes between two reads.
+static constexpr std::uint32_t RING_SIZE = 1 << 20;
+
+static constexpr std::array<char const*, 2> TRACEFS_ROOTS { "/sys/kernel/tracing", "/sys/kernel/debug/tracing" };
+
+// where the programs lay out the record and the counter's key on their stack.
+static constexpr std::int16_t RECORD_OFFSET = -32;
+static constexpr std::int16_t KEY_OFFSET = -40;
+static_assert(sizeof(ProcessTraceRecord) <= static_cast<std::size_t>(-RECORD_OFFSET));
+
+static constexpr std::int16_t record_offset(std::size_t member)
+{
+    return static_cast<std::int16_t>(RECORD_OFFSET + static_cast<std::int16_t>(member));
+}
+
+enum Register : std::uint8_t { R0, R1, R2, R3, R4, R5, R6, R7, R8, R9, R10 };
+
+// the kernel's own instruction macros live in its private headers, these build the same encodings.
+static constexpr bpf_insn instruction(int code, Register destination, Register source, std::int16_t offset, std::int32_t immediate)
+{
+    return bpf_insn {
+        .code = static_cast<std::uint8_t>(code),
+        .dst_reg = static_cast<std::uint8_t>(destination & 0xf),
+        .src_reg = static_cast<std::uint8_t>(source & 0xf),
+        .off = offset,
+        .imm = immediate,
+    };
+}
+
+static constexpr bpf_insn move(Register destination, Register source) { return instruction(BPF_ALU64 | BPF_MOV | BPF_X, destination, source, 0, 0); }
+static constexpr bpf_insn move(Register destination, std::int32_t immediate) { return instruction(BPF_ALU64 | BPF_MOV | BPF_K, destination, R0, 0, immediate); }
+static constexpr bpf_insn arithmetic(int operation, Register destination, std::int32_t immediate) { return instruction(BPF_ALU64 | operation | BPF_K, destination, R0, 0, immediate); }
+static constexpr bpf_insn load(int size, Register destination, Register source, std::int16_t offset) { return instruction(BPF_LDX | size | BPF_MEM, destination, source, offset, 0); }
+static constexpr bpf_insn store(int size, Register destination, std::int16_t offset, Register source) { return instruction(BPF_STX | size | BPF_MEM, destination, source, offset, 0); }
+static constexpr bpf_insn store(int size, Register destination, std::int16_t offset, std::int32_t immediate) { return instruction(BPF_ST | size | BPF_MEM, destination, R0, offset, immediate); }
+static constexpr bpf_insn atomic_add(int size, Register destination, Register source) { return instruction(BPF_STX | size | BPF_ATOMIC, destination, source, 0, BPF_ADD); }
+static constexpr bpf_insn call(bpf_func_id helper) { return instruction(BPF_JMP | BPF_CALL, R0, R0, 0, helper); }
+static constexpr bpf_insn leave() { return instruction(BPF_JMP | BPF_EXIT, R0, R0, 0, 0); }
+
+static long bpf(bpf_cmd command, bpf_attr& attributes)
+{
+    return syscall(SYS_bpf, command, &attributes, sizeof(attributes));
+}
+
+static std::uint64_t address_of(void const* pointer)
+{
+    return reinterpret_cast<std::uintptr_t>(pointer);
+}
+
+// tracefs files don't know their size up front, so they're read until the end.
+static std::optional<std::string> read_text_file(std::string const& path)
+{
+    auto file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) return std::nullopt;
+
+    std::string text {};
+    std::array<char, 4096> buffer {};
+
+    for (ssize_t bytes = 0; (bytes = read(file, buffer.data(), buffer.size())) > 0;)
+    {
+        text.append(buffer.data(), static_cast<std::size_t>(bytes));
+    }
+
+    close(file);
+    return text;
+}
+
+struct TracepointField
+{
+    std::int16_t offset;
+    std::uint32_t size;
+};
+
+// a field's line in a tracepoint's format file reads "field:<type> <name>;\toffset:<n>;\tsize:<n>;\t...".
+static std::optional<TracepointField> find_tracepoint_field(std::string_view format, std::string_view name)
+{
+    auto const fnParseNumber = [] (std::string_view line, std::string_view key) -> std::optional<int> {
+        auto const start = line.find(key);
+        if (start == std::string_view::npos) return std::nullopt;
+
+        int value = 0;
+        auto const* first = line.data() + start + key.size();
+        if (std::from_chars(first, line.data() + line.size(), value).ec != std::errc {}) return std::nullopt;
+
+        return value;
+    };
+
+    for (std::size_t lineStart = 0; lineStart < format.size();)
+    {
+        auto lineEnd = format.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) lineEnd = format.size();
+        auto const line = format.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        auto const declarationEnd = line.find(';');
+        if (!line.contains("field:") || declarationEnd == std::string_view::npos) continue;
+        if (!line.substr(0, declarationEnd).ends_with(fmt::format(" {}", name))) continue;
+
+        auto const offset = fnParseNumber(line, "offset:");
+        auto const size = fnParseNumber(line, "size:");
+        if (!offset || !size) return std::nullopt;
+
+        return TracepointField { static_cast<std::int16_t>(*offset), static_cast<std::uint32_t>(*size) };
+    }
+
+    return std::nullopt;
+}
+
+//
+// The program behind each tracepoint. It runs in the task the event is about:
+// the parent for task_newtask, the process itself for exec and exit. It writes
+// one ProcessTraceRecord into the ring, or when the ring is full it bumps the
+// lost counter instead. Threads are filtered out in the kernel, so they never
+// cost us a wakeup.
+//
+static std::vector<bpf_insn> process_trace_program(ProcessTraceRecord::Kind kind, TracepointField pidField, TracepointField cloneFlagsField, int ring, int lost)
+{
+    std::vector<bpf_insn> program {};
+    std::vector<std::size_t> earlyExits {};
+
+    auto const fnExitIf = [&] (int condition, Register left, std::int32_t right) {
+        earlyExits.push_back(program.size());
+        program.push_back(instruction(BPF_JMP | condition | BPF_K, left, R0, 0, right));
+    };
+
+    auto const fnExitIfNotEqual = [&] (Register left, Register right) {
+        earlyExits.push_back(program.size());
+        program.push_back(instruction(BPF_JMP | BPF_JNE | BPF_X, left, right, 0, 0));
+    };
+
+    // a map is referenced by its file descriptor, in a double-wide load the kernel patches with the map's address.
+    auto const fnLoadMap = [&] (Register destination, int map) {
+        program.push_back(instruction(BPF_LD | BPF_DW | BPF_IMM, destination, static_cast<Register>(BPF_PSEUDO_MAP_FD), 0, map));
+        program.push_back(instruction(0, R0, R0, 0, 0));
+    };
+
+    // r6 keeps the tracepoint's record, r7 the tgid of the task we run in.
+    program.push_back(move(R6, R1));
+    program.push_back(call(BPF_FUNC_get_current_pid_tgid));
+    program.push_back(move(R7, R0));
+    program.push_back(arithmetic(BPF_RSH, R7, 32));
+
+    switch (kind)
+    {
+    case ProcessTraceRecord::Kind::FORK:
+        // a new thread joins its parent's thread group, only a new thread group is a new process.
+        program.push_back(load(cloneFlagsField.size == 8 ? BPF_DW : BPF_W, R8, R6, cloneFlagsField.offset));
+        fnExitIf(BPF_JSET, R8, CLONE_THREAD);
+        program.push_back(load(BPF_W, R9, R6, pidField.offset));
+        program.push_back(store(BPF_W, R10, record_offset(offsetof(ProcessTraceRecord, pid)), R9));
+        program.push_back(store(BPF_W, R10, record_offset(offsetof(ProcessTraceRecord, parentPid)), R7));
+        break;
+    case ProcessTraceRecord::Kind::EXEC:
+        program.push_back(store(BPF_W, R10, record_offset(offsetof(ProcessTraceRecord, pid)), R7));
+        program.push_back(store(BPF_W, R10, record_offset(offsetof(ProcessTraceRecord, parentPid)), 0));
+        break;
+    case ProcessTraceRecord::Kind::EXIT:
+        // exit fires for every thread, only the thread group leader stands for the process.
+        program.push_back(move(R8, R0));
+        program.push_back(arithmetic(BPF_LSH, R8, 32));
+        program.push_back(arithmetic(BPF_RSH, R8, 32));
+        fnExitIfNotEqual(R8, R7);
+        program.push_back(store(BPF_W, R10, record_offset(offsetof(ProcessTraceRecord, pid)), R7));
+        program.push_back(store(BPF_W, R10, record_offset(offsetof(ProcessTraceRecord, parentPid)), 0));
+        break;
+    }
+
+    program.push_back(store(BPF_W, R10, record_offset(offsetof(ProcessTraceRecord, kind)), static_cast<std::int32_t>(kind)));
+
+    // a forked child runs its parent's program until it execs, so the parent's name is the child's too.
+    program.push_back(move(R1, R10));
+    program.push_back(arithmetic(BPF_ADD, R1, record_offset(offsetof(ProcessTraceRecord, name))));
+    program.push_back(move(R2, static_cast<std::int32_t>(sizeof(ProcessTraceRecord::name))));
+    program.push_back(call(BPF_FUNC_get_current_comm));
+
+    fnLoadMap(R1, ring);
+    program.push_back(move(R2, R10));
+    program.push_back(arithmetic(BPF_ADD, R2, RECORD_OFFSET));
+    program.push_back(move(R3, static_cast<std::int32_t>(sizeof(ProcessTraceRecord))));
+    program.push_back(move(R4, 0));
+    program.push_back(call(BPF_FUNC_ringbuf_output));
+    fnExitIf(BPF_JEQ, R0, 0);
+
+    program.push_back(store(BPF_W, R10, KEY_OFFSET, 0));
+    fnLoadMap(R1, lost);
+    program.push_back(move(R2, R10));
+    program.push_back(arithmetic(BPF_ADD, R2, KEY_OFFSET));
+    program.push_back(call(BPF_FUNC_map_lookup_elem));
+    fnExitIf(BPF_JEQ, R0, 0);
+    program.push_back(move(R1, 1));
+    program.push_back(atomic_add(BPF_DW, R0, R1));
+
+    for (auto const jump : earlyExits)
+    {
+        program[jump].off = static_cast<std::int16_t>(program.size() - jump - 1);
+    }
+
+    program.push_back(move(R0, 0));
+    program.push_back(leave());
+
+    return program;
+}
+
+static Result<int> load_program(std::vector<bpf_insn> const& program)
+{
+    static constexpr char LICENSE[] = "GPL";
+
+    bpf_attr attributes {};
+    attributes.prog_type = BPF_PROG_TYPE_TRACEPOINT;
+    attributes.insns = address_of(program.data());
+    attributes.insn_cnt = static_cast<std::uint32_t>(program.size());
+    attributes.license = address_of(LICENSE);
+
+    auto const descriptor = bpf(BPF_PROG_LOAD, attributes);
+    if (descriptor >= 0) return static_cast<int>(descriptor);
+
+    auto const loadError = errno;
+
+    // the verifier only explains itself when asked to, which is only worth it once it has said no.
+    std::string log(16384, '\0');
+    attributes.log_level = 1;
+    attributes.log_buf = address_of(log.data());
+    attributes.log_size = static_cast<std::uint32_t>(log.size());
+
+    if (auto const retried = bpf(BPF_PROG_LOAD, attributes); retried >= 0)
+    {
+        return static_cast<int>(retried);
+    }
+
+    std::string_view verdict { log.c_str() };
+    while (verdict.ends_with('\n')) verdict.remove_suffix(1);
+    verdict = verdict.substr(verdict.find_last_of('\n') + 1);
+
+    return make_error("BPF_PROG_LOAD failed with: {} {}", std::strerror(loadError), verdict);
+}
+
+static Result<int> create_map(bpf_map_type type, std::uint32_t valueSize, std::uint32_t entries, std::uint32_t flags)
+{
+    bpf_attr attributes {};
+    attributes.map_type = type;
+    attributes.key_size = type == BPF_MAP_TYPE_RINGBUF ? 0 : sizeof(std::uint32_t);
+    attributes.value_size = valueSize;
+    attributes.max_entries = entries;
+    attributes.map_flags = flags;
+
+    auto const descriptor = bpf(BPF_MAP_CREATE, attributes);
+    if (descriptor < 0)
+    {
+        return make_error("BPF_MAP_CREATE failed with: {}", std::strerror(errno));
+    }
+
+    return static_cast<int>(descriptor);
+}
+
+// a single perf event on one cpu is enough, a tracepoint runs its programs wherever it fires.
+static Result<int> attach_to_tracepoint(std::string const& events, std::string_view tracepoint, int program)
+{
+    auto const idText = read_text_file(fmt::format("{}/{}/id", events, tracepoint));
+    std::uint64_t id = 0;
+    if (!idText || std::from_chars(idText->data(), idText->data() + idText->size(), id).ec != std::errc {})
+    {
+        return make_error("couldn't read the id of tracepoint {}", tracepoint);
+    }
+
+    perf_event_attr attributes {};
+    attributes.type = PERF_TYPE_TRACEPOINT;
+    attributes.size = sizeof(attributes);
+    attributes.config = id;
+    attributes.sample_period = 1;
+    attributes.wakeup_events = 1;
+
+    auto const event = static_cast<int>(syscall(SYS_perf_event_open, &attributes, -1, 0, -1, PERF_FLAG_FD_CLOEXEC));
+    if (event < 0)
+    {
+        return make_error("perf_event_open failed for tracepoint {} with: {}", tracepoint, std::strerror(errno));
+    }
+
+    if (ioctl(event, PERF_EVENT_IOC_SET_BPF, program) != 0 || ioctl(event, PERF_EVENT_IOC_ENABLE, 0) != 0)
+    {
+        auto const attachError = errno;
+        close(event);
+        return make_error("attaching to tracepoint {} failed with: {}", tracepoint, std::strerror(attachError));
+    }
+
+    return event;
+}
+
+static std::size_t page_size()
+{
+    static auto const PAGE_SIZE = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return PAGE_SIZE;
+}
+
+static Result<void> set_up_process_trace(ProcessTraceSubscription& subscription)
+{
+    auto const* tracefs = std::ranges::find_if(TRACEFS_ROOTS, [] (char const* root) {
+        return access(fmt::format("{}/events", root).c_str(), R_OK) == 0;
+    });
+
+    if (tracefs == TRACEFS_ROOTS.end())
+    {
+        return make_error("tracefs isn't mounted, or isn't readable to us");
+    }
+
+    auto const events = fmt::format("{}/events", *tracefs);
+
+    // the layout of task_newtask's record is only stable within a kernel, so it's read from its format.
+    auto const format = read_text_file(fmt::format("{}/task/task_newtask/format", events));
+    auto const pidField = format ? find_tracepoint_field(*format, "pid") : std::nullopt;
+    auto const cloneFlagsField = format ? find_tracepoint_field(*format, "clone_flags") : std::nullopt;
+
+    if (!pidField || pidField->size != sizeof(std::uint32_t) || !cloneFlagsField || (cloneFlagsField->size != 8 && cloneFlagsField->size != 4))
+    {
+        return make_error("couldn't read the layout of tracepoint task/task_newtask");
+    }
+
+    subscription.ring = TRY(create_map(BPF_MAP_TYPE_RINGBUF, 0, RING_SIZE, 0));
+    subscription.lost = TRY(create_map(BPF_MAP_TYPE_ARRAY, sizeof(std::uint64_t), 1, BPF_F_MMAPABLE));
+
+    // the consumer position is ours to write, the producer position and the data after it are the kernel's, mapped twice over so a record never wraps.
+    auto* consumer = mmap(nullptr, page_size(), PROT_READ | PROT_WRITE, MAP_SHARED, subscription.ring, 0);
+    auto* producer = mmap(nullptr, page_size() + 2 * RING_SIZE, PROT_READ, MAP_SHARED, subscription.ring, static_cast<off_t>(page_size()));
+    auto* lostCounter = mmap(nullptr, page_size(), PROT_READ, MAP_SHARED, subscription.lost, 0);
+
+    subscription.consumer = consumer == MAP_FAILED ? nullptr : consumer;
+    subscription.producer = producer == MAP_FAILED ? nullptr : producer;
+    subscription.lostCounter = lostCounter == MAP_FAILED ? nullptr : lostCounter;
+
+    if (subscription.consumer == nullptr || subscription.producer == nullptr || subscription.lostCounter == nullptr)
+    {
+        return make_error("mapping the ring failed with: {}", std::strerror(errno));
+    }
+
+    static constexpr std::array<std::pair<ProcessTraceRecord::Kind, std::string_view>, 3> TRACEPOINTS {{
+        { ProcessTraceRecord::Kind::FORK, "task/task_newtask" },
+        { ProcessTraceRecord::Kind::EXEC, "sched/sched_process_exec" },
+        { ProcessTraceRecord::Kind::EXIT, "sched/sched_process_exit" },
+    }};
+
+    for (auto const& [kind, tracepoint] : TRACEPOINTS)
+    {
+        auto const program = TRY(load_program(process_trace_program(kind, *pidField, *cloneFlagsField, subscription.ring, subscription.lost)));
+        subscription.descriptors.push_back(program);
+        subscription.descriptors.push_back(TRY(attach_to_tracepoint(events, tracepoint, program)));
+    }
+
+    return {};
+}
+
+Result<ProcessTraceSubscription> subscribe_to_process_trace_events()
+{
+    ProcessTraceSubscription subscription {};
+
+    if (auto result = set_up_process_trace(subscription); !result)
+    {
+        unsubscribe_from_process_trace_events(subscription);
+        return make_error("{}", result.error().message());
+    }
+
+    return subscription;
+}
+
+void unsubscribe_from_process_trace_events(ProcessTraceSubscription& subscription)
+{
+    // the perf events go first, they hold the programs, which hold the maps.
+    for (auto const descriptor : subscription.descriptors | std::views::reverse)
+    {
+        close(descriptor);
+    }
+
+    if (subscription.consumer != nullptr) munmap(subscription.consumer, page_size());
+    if (subscription.producer != nullptr) munmap(subscription.producer, page_size() + 2 * RING_SIZE);
+    if (subscription.lostCounter != nullptr) munmap(subscription.lostCounter, page_size());
+    if (subscription.ring >= 0) close(subscription.ring);
+    if (subscription.lost >= 0) close(subscription.lost);
+
+    subscription = {};
+}
+
+std::uint64_t read_process_trace_events(ProcessTraceSubscription& subscription, std::vector<ProcessTraceRecord>& records)
+{
+    std::atomic_ref consumerPosition { *static_cast<unsigned long*>(subscription.consumer) };
+    std::atomic_ref const producerPosition { *static_cast<unsigned long*>(subscription.producer) };
+    auto* const data = static_cast<std::byte*>(subscription.producer) + page_size();
+
+    auto position = consumerPosition.load(std::memory_order_relaxed);
+    auto const end = producerPosition.load(std::memory_order_acquire);
+
+    while (position < end)
+    {
+        auto* const header = data + (position & (RING_SIZE - 1));
+        auto const length = std::atomic_ref { *reinterpret_cast<std::uint32_t*>(header) }.load(std::memory_order_acquire);
+
+        // reserved but not written yet, it and whatever comes after it wait for the next read.
+        if (length & BPF_RINGBUF_BUSY_BIT) break;
+
+        auto const size = length & ~static_cast<std::uint32_t>(BPF_RINGBUF_DISCARD_BIT);
+        if (!(length & BPF_RINGBUF_DISCARD_BIT) && size == sizeof(ProcessTraceRecord))
+        {
+            std::memcpy(&records.emplace_back(), header + BPF_RINGBUF_HDR_SZ, sizeof(ProcessTraceRecord));
+        }
+
+        position += (size + BPF_RINGBUF_HDR_SZ + 7) & ~7ul;
+    }
+
+    consumerPosition.store(position, std::memory_order_release);
+
+    auto const lostEvents = std::atomic_ref { *static_cast<std::uint64_t*>(subscription.lostCounter) }.load(std::memory_order_relaxed);
+    auto const dropped = lostEvents - subscription.lostEvents;
+    subscription.lostEvents = lostEvents;
+
+    return dropped;
+}
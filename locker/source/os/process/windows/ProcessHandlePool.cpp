@@ -0,0 +1,20 @@
+#include "os/process/windows/ProcessHandlePool.hpp"
+
+using namespace liberror;
+
+Result<ProcessHandle> ProcessHandlePool::acquire(ProcessId pid)
+{
+    if (auto handle = handles.find(pid); handle != handles.end())
+    {
+        return handle->second;
+    }
+
+    auto processHandle = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (processHandle == nullptr)
+    {
+        return make_error("OpenProcess failed for process {} with: {:x}", pid, GetLastError());
+    }
+
+    auto [handle, _] = handles.emplace(pid, ProcessHandle { processHandle, CloseHandle });
+    return handle->second;
+}
@@ -0,0 +1,169 @@
+#include "os/process/windows/ProcessTrace.hpp"
+
+#include <tdh.h>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace liberror;
+
+// {22FB2CD6-0E7B-422B-A0C7-2FAD1FD0E716}
+static constexpr GUID KERNEL_PROCESS_PROVIDER = { 0x22FB2CD6, 0x0E7B, 0x422B, { 0xA0, 0xC7, 0x2F, 0xAD, 0x1F, 0xD0, 0xE7, 0x16 } };
+static constexpr ULONGLONG KERNEL_PROCESS_KEYWORD = 0x10;
+static constexpr USHORT PROCESS_START_EVENT = 1;
+static constexpr USHORT PROCESS_STOP_EVENT = 2;
+
+static constexpr wchar_t SESSION_NAME[] = L"locker-process-trace";
+
+static std::optional<std::uint32_t> read_uint32_property(EVENT_RECORD* record, wchar_t const* name)
+{
+    PROPERTY_DATA_DESCRIPTOR descriptor {};
+    descriptor.PropertyName = reinterpret_cast<ULONGLONG>(name);
+    descriptor.ArrayIndex = ULONG_MAX;
+
+    std::uint32_t value = 0;
+    if (TdhGetProperty(record, 0, nullptr, 1, &descriptor, sizeof(value), reinterpret_cast<PBYTE>(&value)) != ERROR_SUCCESS)
+    {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+// the start event carries the image name as UTF-16 and the stop event as ANSI, so the bytes are decoded by size.
+static std::optional<std::string> read_image_name_property(EVENT_RECORD* record)
+{
+    PROPERTY_DATA_DESCRIPTOR descriptor {};
+    descriptor.PropertyName = reinterpret_cast<ULONGLONG>(L"ImageName");
+    descriptor.ArrayIndex = ULONG_MAX;
+
+    ULONG size = 0;
+    if (TdhGetPropertySize(record, 0, nullptr, 1, &descriptor, &size) != ERROR_SUCCESS || size == 0)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<BYTE> buffer(size);
+    if (TdhGetProperty(record, 0, nullptr, 1, &descriptor, size, buffer.data()) != ERROR_SUCCESS)
+    {
+        return std::nullopt;
+    }
+
+    std::string imageName {};
+
+    if (record->EventHeader.EventDescriptor.Id == PROCESS_START_EVENT)
+    {
+        std::wstring_view imageNameView { reinterpret_cast<wchar_t const*>(buffer.data()), size / sizeof(wchar_t) };
+        imageNameView = imageNameView.substr(0, imageNameView.find(L'\0'));
+        imageName = std::string(imageNameView.begin(), imageNameView.end());
+    }
+    else
+    {
+        std::string_view imageNameView { reinterpret_cast<char const*>(buffer.data()), size };
+        imageName = imageNameView.substr(0, imageNameView.find('\0'));
+    }
+
+    // the kernel reports full device paths, WMI and the process scan only know the file name.
+    return imageName.substr(imageName.find_last_of('\\') + 1);
+}
+
+static void WINAPI on_process_trace_event(EVENT_RECORD* record)
+{
+    if (!IsEqualGUID(record->EventHeader.ProviderId, KERNEL_PROCESS_PROVIDER)) return;
+
+    auto const id = record->EventHeader.EventDescriptor.Id;
+    if (id != PROCESS_START_EVENT && id != PROCESS_STOP_EVENT) return;
+
+    auto const pid = read_uint32_property(record, L"ProcessID");
+    auto const name = read_image_name_property(record);
+    if (!pid || !name) return;
+
+    auto& queue = *static_cast<ProcessEventQueue*>(record->UserContext);
+    auto const kind = id == PROCESS_START_EVENT ? ProcessEvent::Kind::CREATED : ProcessEvent::Kind::DELETED;
+    auto const parentPid = id == PROCESS_START_EVENT ? read_uint32_property(record, L"ParentProcessID").value_or(0) : 0;
+
+    queue.push({ kind, *pid, *name, parentPid });
+}
+
+static EVENT_TRACE_PROPERTIES* trace_properties(std::vector<std::byte>& buffer)
+{
+    buffer.assign(sizeof(EVENT_TRACE_PROPERTIES) + sizeof(SESSION_NAME), std::byte {});
+
+    auto* properties = reinterpret_cast<EVENT_TRACE_PROPERTIES*>(buffer.data());
+    properties->Wnode.BufferSize = static_cast<ULONG>(buffer.size());
+    properties->Wnode.Flags = WNODE_FLAG_TRACED_GUID;
+    properties->Wnode.ClientContext = 1;
+    properties->LogFileMode = EVENT_TRACE_REAL_TIME_MODE;
+    properties->FlushTimer = 1;
+    properties->LoggerNameOffset = sizeof(EVENT_TRACE_PROPERTIES);
+
+    return properties;
+}
+
+Result<ProcessTraceSubscription> subscribe_to_process_trace_events(ProcessEventQueue& queue)
+{
+    ProcessTraceSubscription subscription {};
+
+    auto result = StartTraceW(&subscription.session, SESSION_NAME, trace_properties(subscription.properties));
+
+    // a previous run that didn't shut down cleanly leaves its session behind.
+    if (result == ERROR_ALREADY_EXISTS)
+    {
+        ControlTraceW(0, SESSION_NAME, trace_properties(subscription.properties), EVENT_TRACE_CONTROL_STOP);
+        result = StartTraceW(&subscription.session, SESSION_NAME, trace_properties(subscription.properties));
+    }
+
+    if (result != ERROR_SUCCESS)
+    {
+        return make_error("StartTrace failed with: {:x}", result);
+    }
+
+    result = EnableTraceEx2(subscription.session, &KERNEL_PROCESS_PROVIDER, EVENT_CONTROL_CODE_ENABLE_PROVIDER, TRACE_LEVEL_INFORMATION, KERNEL_PROCESS_KEYWORD, 0, 0, nullptr);
+    if (result != ERROR_SUCCESS)
+    {
+        unsubscribe_from_process_trace_events(subscription);
+        return make_error("EnableTraceEx2 failed with: {:x}", result);
+    }
+
+    EVENT_TRACE_LOGFILEW logfile {};
+    logfile.LoggerName = const_cast<LPWSTR>(SESSION_NAME);
+    logfile.ProcessTraceMode = PROCESS_TRACE_MODE_REAL_TIME | PROCESS_TRACE_MODE_EVENT_RECORD;
+    logfile.EventRecordCallback = on_process_trace_event;
+    logfile.Context = &queue;
+
+    subscription.trace = OpenTraceW(&logfile);
+    if (subscription.trace == INVALID_PROCESSTRACE_HANDLE)
+    {
+        unsubscribe_from_process_trace_events(subscription);
+        return make_error("OpenTrace failed with: {:x}", GetLastError());
+    }
+
+    // ProcessTrace blocks, dispatching events, until the session is stopped.
+    subscription.consumer = std::jthread([trace = subscription.trace] {
+        auto handle = trace;
+        ProcessTrace(&handle, 1, nullptr, nullptr);
+    });
+
+    return subscription;
+}
+
+void unsubscribe_from_process_trace_events(ProcessTraceSubscription& subscription)
+{
+    if (subscription.session != 0)
+    {
+        ControlTraceW(subscription.session, nullptr, trace_properties(subscription.properties), EVENT_TRACE_CONTROL_STOP);
+    }
+
+    if (subscription.trace != 0 && subscription.trace != INVALID_PROCESSTRACE_HANDLE)
+    {
+        CloseTrace(subscription.trace);
+    }
+
+    if (subscription.consumer.joinable()) subscription.consumer.join();
+
+    subscription.session = 0;
+    subscription.trace = 0;
+}
@@ -0,0 +1,189 @@
+#include "os/process/windows/ProcessWatcher.hpp"
+
+using namespace liberror;
+
+ProcessInfo get_started_process_info(IWbemClassObject* object)
+{
+    ProcessInfo processInfo {};
+    VARIANT variant;
+    if (SUCCEEDED(object->Get(L"TargetInstance", 0, &variant, 0, 0)))
+    {
+        IUnknown* unknown = variant.punkVal;
+        IWbemClassObject* process = nullptr;
+        unknown->QueryInterface(IID_IWbemClassObject, reinterpret_cast<void**>(&process));
+        if (process)
+        {
+            VARIANT processId;
+            process->Get(L"ProcessId", 0, &processId, 0, 0);
+            VARIANT processName;
+            process->Get(L"Name", 0, &processName, 0, 0);
+            VARIANT parentProcessId;
+            process->Get(L"ParentProcessId", 0, &parentProcessId, 0, 0);
+
+            std::wstring_view processNameView { processName.bstrVal };
+            processInfo.name = std::string(processNameView.begin(), processNameView.end());
+            processInfo.pid = static_cast<ProcessId>(processId.intVal);
+            processInfo.parentPid = static_cast<ProcessId>(parentProcessId.intVal);
+
+            VariantClear(&parentProcessId);
+            VariantClear(&processName);
+            VariantClear(&processId);
+        }
+    }
+    VariantClear(&variant);
+    return processInfo;
+}
+
+Result<void> initialize_com()
+{
+    auto result = CoInitializeEx(0, COINIT_MULTITHREADED);
+    if (FAILED(result))
+    {
+        return make_error("Failed to initialize COM!");
+    }
+
+    result = CoInitializeSecurity(NULL, -1, NULL, NULL, RPC_C_AUTHN_LEVEL_DEFAULT, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE, NULL);
+    if (FAILED(result))
+    {
+        CoUninitialize();
+        return make_error("CoInitializeSecurity failed with: {:x}", result);
+    }
+
+    return {};
+}
+
+Result<void> connect_to_wmi(IWbemLocator*& locator, IWbemServices*& service)
+{
+    auto result = CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER, IID_IWbemLocator, reinterpret_cast<LPVOID*>(&locator));
+    if (FAILED(result))
+    {
+        CoUninitialize();
+        return make_error("CoCreateInstance failed with: {:x}", result);
+    }
+
+    result = locator->ConnectServer(BSTR(L"ROOT\\CIMV2"), NULL, NULL, 0, NULL, 0, 0, &service);
+    if (FAILED(result))
+    {
+        CoUninitialize();
+        return make_error("ConnectServer failed with: {:x}", result);
+    }
+
+    return {};
+}
+
+Result<void> set_wmi_proxy_blanket(IWbemLocator* locator, IWbemServices* service)
+{
+    auto result = CoSetProxyBlanket(service, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL, RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE);
+
+    if (FAILED(result))
+    {
+        locator->Release();
+        CoUninitialize();
+        return make_error("CoSetProxyBlanket failed with: {:x}", result);
+    }
+
+    return {};
+}
+
+ProcessEventSink::ProcessEventSink(ProcessEventQueue& eventQueue, ProcessEvent::Kind eventKind)
+    : queue(eventQueue)
+    , kind(eventKind)
+{}
+
+ULONG ProcessEventSink::AddRef()
+{
+    return static_cast<ULONG>(InterlockedIncrement(&references));
+}
+
+ULONG ProcessEventSink::Release()
+{
+    auto const count = InterlockedDecrement(&references);
+    if (count == 0) delete this;
+    return static_cast<ULONG>(count);
+}
+
+HRESULT ProcessEventSink::QueryInterface(REFIID riid, void** object)
+{
+    if (riid == IID_IUnknown || riid == IID_IWbemObjectSink)
+    {
+        *object = static_cast<IWbemObjectSink*>(this);
+        AddRef();
+        return WBEM_S_NO_ERROR;
+    }
+
+    return E_NOINTERFACE;
+}
+
+HRESULT ProcessEventSink::Indicate(LONG objectCount, IWbemClassObject __RPC_FAR* __RPC_FAR* objects)
+{
+    for (auto i = 0; i < objectCount; i += 1)
+    {
+        auto const processInfo = get_started_process_info(objects[i]);
+        queue.push({ kind, processInfo.pid, processInfo.name, processInfo.parentPid });
+    }
+
+    return WBEM_S_NO_ERROR;
+}
+
+HRESULT ProcessEventSink::SetStatus(LONG, HRESULT, BSTR, IWbemClassObject __RPC_FAR*)
+{
+    return WBEM_S_NO_ERROR;
+}
+
+static Result<ProcessEventSubscription> subscribe_to_process_events(IWbemLocator* locator, IWbemServices* service, ProcessEventQueue& queue, ProcessEvent::Kind kind, BSTR query)
+{
+    ProcessEventSubscription subscription {};
+
+    auto result = CoCreateInstance(CLSID_UnsecuredApartment, NULL, CLSCTX_LOCAL_SERVER, IID_IUnsecuredApartment, reinterpret_cast<void**>(&subscription.apartment));
+    if (FAILED(result))
+    {
+        locator->Release();
+        CoUninitialize();
+        return make_error("CoCreateInstance failed with: {:x}", result);
+    }
+
+    // WMI calls back through a stub living in an unsecured apartment, the sink itself stays in-process.
+    subscription.sink = new ProcessEventSink(queue, kind);
+
+    IUnknown* stubUnknown = nullptr;
+    subscription.apartment->CreateObjectStub(subscription.sink, &stubUnknown);
+    stubUnknown->QueryInterface(IID_IWbemObjectSink, reinterpret_cast<void**>(&subscription.stub));
+    stubUnknown->Release();
+
+    result = service->ExecNotificationQueryAsync(BSTR(L"WQL"), query, WBEM_FLAG_SEND_STATUS, NULL, subscription.stub);
+    if (FAILED(result))
+    {
+        unsubscribe_from_process_events(service, subscription);
+        locator->Release();
+        CoUninitialize();
+        return make_error("ExecNotificationQueryAsync failed with: {:x}", result);
+    }
+
+    return subscription;
+}
+
+Result<ProcessEventSubscription> subscribe_to_process_creation_events(IWbemLocator* locator, IWbemServices* service, ProcessEventQueue& queue)
+{
+    auto constexpr static query = BSTR(L"SELECT * FROM __InstanceCreationEvent WITHIN 1 WHERE TargetInstance ISA 'Win32_Process'");
+    return subscribe_to_process_events(locator, service, queue, ProcessEvent::Kind::CREATED, query);
+}
+
+Result<ProcessEventSubscription> subscribe_to_process_deletion_events(IWbemLocator* locator, IWbemServices* service, ProcessEventQueue& queue)
+{
+    auto constexpr static query = BSTR(L"SELECT * FROM __InstanceDeletionEvent WITHIN 1 WHERE TargetInstance ISA 'Win32_Process'");
+    return subscribe_to_process_events(locator, service, queue, ProcessEvent::Kind::DELETED, query);
+}
+
+void unsubscribe_from_process_events(IWbemServices* service, ProcessEventSubscription& subscription)
+{
+    if (subscription.stub != nullptr)
+    {
+        service->CancelAsyncCall(subscription.stub);
+        subscription.stub->Release();
+    }
+
+    if (subscription.sink != nullptr) subscription.sink->Release();
+    if (subscription.apartment != nullptr) subscription.apartment->Release();
+
+    subscription = {};
+}
@@ -0,0 +1,43 @@
+#include "os/process/windows/ThreadIndex.hpp"
+
+#include <TlHelp32.h>
+
+#include <algorithm>
+
+using namespace liberror;
+
+Result<void> ThreadIndex::refresh()
+{
+    auto snapshotHandler = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshotHandler == INVALID_HANDLE_VALUE) return make_error("CreateToolhelp32Snapshot failed.");
+
+    entries.clear();
+
+    THREADENTRY32 entry {};
+    entry.dwSize = sizeof(THREADENTRY32);
+
+    if (Thread32First(snapshotHandler, &entry))
+    {
+        do
+        {
+            entries.emplace_back(entry.th32OwnerProcessID, entry.th32ThreadID);
+        } while (Thread32Next(snapshotHandler, &entry));
+    }
+
+    CloseHandle(snapshotHandler);
+
+    std::ranges::sort(entries, {}, &ThreadEntry::pid);
+    stale = false;
+
+    return {};
+}
+
+Result<std::span<ThreadEntry const>> ThreadIndex::threads_of(DWORD pid)
+{
+    if (stale) TRY(refresh());
+
+    auto const threads = std::ranges::equal_range(entries, pid, {}, &ThreadEntry::pid);
+    if (threads.empty()) return make_error("No threads found for process {}", pid);
+
+    return std::span<ThreadEntry const> { threads.begin(), threads.end() };
+}
@@ -0,0 +1,335 @@
+#include "os/process/windows/WindowsProcessBackend.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <processthreadsapi.h>
+#include <psapi.h>
+
+#include <algorithm>
+#include <ranges>
+#include <vector>
+
+using namespace liberror;
+
+static std::string trim(std::string const& value)
+{
+    auto result = value;
+    result.erase(result.begin(), std::ranges::find_if(result, [] (auto character) { return !std::isspace(character); }));
+    result.erase(std::ranges::find_if(result.rbegin(), result.rend(), [] (auto character) { return !std::isspace(character); }).base(), result.end());
+    return result;
+}
+
+// one snapshot hands back every process with its image name, no per-process handle or syscall needed.
+static Result<void> scan_processes_with_snapshot(ProcessTable& processes)
+{
+    auto snapshotHandler = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshotHandler == INVALID_HANDLE_VALUE) return make_error("CreateToolhelp32Snapshot failed.");
+
+    PROCESSENTRY32W entry {};
+    entry.dwSize = sizeof(PROCESSENTRY32W);
+
+    if (Process32FirstW(snapshotHandler, &entry))
+    {
+        do
+        {
+            if (entry.th32ProcessID == 0) continue;
+            std::wstring_view processNameView { entry.szExeFile };
+            auto processName = std::string(processNameView.begin(), processNameView.end());
+            processes[processName].emplace_back(processName, entry.th32ProcessID, entry.th32ParentProcessID);
+        } while (Process32NextW(snapshotHandler, &entry));
+    }
+
+    CloseHandle(snapshotHandler);
+
+    return {};
+}
+
+static Result<void> scan_processes_with_handles(ProcessTable& processes)
+{
+    std::vector<DWORD> processesArray(1024);
+    DWORD processBytes = 0;
+
+    while (true)
+    {
+        auto const arrayBytes = static_cast<DWORD>(processesArray.size() * sizeof(DWORD));
+        if (!EnumProcesses(processesArray.data(), arrayBytes, &processBytes))
+        {
+            return make_error("Failed to fetch processes");
+        }
+        // a full buffer means there may have been more processes than it could hold.
+        if (processBytes < arrayBytes) break;
+        processesArray.resize(processesArray.size() * 2);
+    }
+
+    for (auto i = 0zu; i < processBytes / sizeof(DWORD); i += 1)
+    {
+        auto pid = processesArray[i];
+        if (pid == 0) continue;
+        TCHAR processName[MAX_PATH] = TEXT("INVALID");
+        HANDLE processHandle = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
+        if (processHandle == nullptr) continue;
+        HMODULE module;
+        DWORD modulesCount;
+        if (EnumProcessModules(processHandle, &module, 8, &modulesCount))
+        {
+            GetModuleBaseName(processHandle, module, processName, sizeof(processName)/sizeof(TCHAR));
+        }
+        CloseHandle(processHandle);
+        if (trim(processName) == "INVALID") continue;
+        processes[trim(processName)].emplace_back(trim(processName), pid);
+    }
+
+    return {};
+}
+
+Result<void> WindowsProcessSource::start(ProcessEventQueue& queue)
+{
+    TRY(initialize_com());
+    TRY(connect_to_wmi(locator, service));
+    TRY(set_wmi_proxy_blanket(locator, service));
+
+    // the kernel trace needs administrator rights, without them the same events come from WMI instead.
+    auto subscription = subscribe_to_process_trace_events(queue);
+    if (subscription)
+    {
+        traceSubscription = std::move(subscription).value();
+        return {};
+    }
+
+    spdlog::warn("Falling back to WMI process events: {}", subscription.error().message());
+
+    creationSubscription = TRY(subscribe_to_process_creation_events(locator, service, queue));
+    deletionSubscription = TRY(subscribe_to_process_deletion_events(locator, service, queue));
+
+    return {};
+}
+
+void WindowsProcessSource::stop()
+{
+    if (traceSubscription) unsubscribe_from_process_trace_events(*traceSubscription);
+    traceSubscription.reset();
+
+    if (service != nullptr)
+    {
+        unsubscribe_from_process_events(service, creationSubscription);
+        unsubscribe_from_process_events(service, deletionSubscription);
+        service->Release();
+        locator->Release();
+        CoUninitialize();
+    }
+
+    service = nullptr;
+    locator = nullptr;
+}
+
+Result<ProcessTable> WindowsProcessSource::scan()
+{
+    ProcessTable processes {};
+
+    if (auto result = scan_processes_with_snapshot(processes); !result)
+    {
+        processes.clear();
+        TRY(scan_processes_with_handles(processes));
+    }
+
+    return processes;
+}
+
+Result<ProcessUsage> WindowsProcessSource::usage(ProcessId pid) const
+{
+    HANDLE processHandle = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (processHandle == nullptr)
+    {
+        return make_error("Failed to open process {} with: {}", pid, GetLastError());
+    }
+
+    FILETIME creationTime {};
+    FILETIME exitTime {};
+    FILETIME kernelTime {};
+    FILETIME userTime {};
+    PROCESS_MEMORY_COUNTERS memoryCounters {};
+
+    auto const hasTimes = GetProcessTimes(processHandle, &creationTime, &exitTime, &kernelTime, &userTime);
+    auto const hasMemory = GetProcessMemoryInfo(processHandle, &memoryCounters, sizeof(memoryCounters));
+    CloseHandle(processHandle);
+
+    if (!hasTimes || !hasMemory)
+    {
+        return make_error("Failed to query the usage of process {}", pid);
+    }
+
+    auto const fnTicks = [] (FILETIME const& time) {
+        return (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+
+    // FILETIME counts in 100ns ticks.
+    return ProcessUsage {
+        .cpuTime = std::chrono::nanoseconds { static_cast<std::int64_t>((fnTicks(kernelTime) + fnTicks(userTime)) * 100) },
+        .residentBytes = memoryCounters.WorkingSetSize,
+    };
+}
+
+Result<void> WindowsProcessController::track(ProcessInfo& process)
+{
+    process.handle = TRY(processHandles.acquire(process.pid));
+    return {};
+}
+
+bool WindowsProcessController::has_exited(ProcessInfo const& process) const
+{
+    if (process.handle == nullptr) return false;
+    return WaitForSingleObject(process.handle.get(), 0) == WAIT_OBJECT_0;
+}
+
+// the threads an operation has got to so far in one process, kept open so a failure later on can still undo them.
+struct ProcessThreads
+{
+    std::vector<DWORD> threadIds {};
+    std::vector<HANDLE> threadHandles {};
+
+    ProcessThreads() = default;
+    ProcessThreads(ProcessThreads const&) = delete;
+    ProcessThreads& operator=(ProcessThreads const&) = delete;
+    ~ProcessThreads() { std::ranges::for_each(threadHandles, CloseHandle); }
+};
+
+//
+// Applies fnThreadOperation to every thread of the process that isn't in
+// threads yet, and reports whether there were any. A thread that exited since
+// the index was built is skipped, but any other failure undoes every thread
+// done so far with fnUndoOperation, so the process is never left half frozen.
+//
+static Result<bool> for_each_new_process_thread(WindowsProcessController const& controller, ProcessInfo const& processInfo, ThreadIndex& threadIndex, ProcessThreads& threads, auto&& fnThreadOperation, auto&& fnUndoOperation)
+{
+    auto const fnUndo = [&] {
+        std::ranges::for_each(threads.threadHandles | std::views::reverse, fnUndoOperation);
+        std::ranges::for_each(threads.threadHandles, CloseHandle);
+        threads.threadHandles.clear();
+        threads.threadIds.clear();
+    };
+
+    // the handle keeps the pid reserved until it is signaled, past that point the pid may belong to someone else.
+    if (controller.has_exited(processInfo))
+    {
+        fnUndo();
+        return make_error("Process {} has already exited", processInfo.pid);
+    }
+
+    auto const processThreads = threadIndex.threads_of(processInfo.pid);
+    if (!processThreads)
+    {
+        fnUndo();
+        return make_error("{}", processThreads.error().message());
+    }
+
+    auto const threadsBefore = threads.threadIds.size();
+
+    for (auto const& thread : *processThreads)
+    {
+        if (std::ranges::find(threads.threadIds, thread.tid) != threads.threadIds.end()) continue;
+
+        auto processThreadHandle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT, FALSE, thread.tid);
+
+        if (processThreadHandle == nullptr && GetLastError() == ERROR_INVALID_PARAMETER)
+        {
+            continue;
+        }
+
+        if (processThreadHandle == nullptr || fnThreadOperation(processThreadHandle) == static_cast<DWORD>(-1))
+        {
+            auto const error = GetLastError();
+
+            if (processThreadHandle != nullptr) CloseHandle(processThreadHandle);
+            fnUndo();
+
+            return make_error("Failed to operate on thread {} of process {}, error {}", thread.tid, processInfo.pid, error);
+        }
+
+        threads.threadIds.push_back(thread.tid);
+        threads.threadHandles.push_back(processThreadHandle);
+    }
+
+    return threads.threadIds.size() != threadsBefore;
+}
+
+// SuspendThread only asks for the thread to stop; reading its registers waits until it has, since they are only there to read once it is off its cpu.
+static DWORD suspend_thread_and_wait(HANDLE thread)
+{
+    auto const suspendCount = SuspendThread(thread);
+    if (suspendCount == static_cast<DWORD>(-1)) return suspendCount;
+
+    CONTEXT context {};
+    context.ContextFlags = CONTEXT_CONTROL;
+
+    if (!GetThreadContext(thread, &context))
+    {
+        auto const error = GetLastError();
+        ResumeThread(thread);
+        SetLastError(error);
+        return static_cast<DWORD>(-1);
+    }
+
+    return suspendCount;
+}
+
+//
+// Every process shares the same thread index, so a pass over the batch costs
+// one snapshot. A thread started after the snapshot was taken isn't in it, so
+// the batch goes again on a fresh one until no process has a thread it hasn't
+// suspended yet. Suspended threads can't start any more, so that settles
+// quickly.
+//
+std::vector<ProcessOperationResult> WindowsProcessController::suspend(std::span<ProcessInfo const> processes)
+{
+    std::vector<ProcessOperationResult> results {};
+    results.reserve(processes.size());
+
+    std::vector<ProcessThreads> threads(processes.size());
+
+    for (auto const& processInfo : processes)
+    {
+        results.emplace_back(processInfo.pid, Result<void> {});
+    }
+
+    for (auto anyNewThreads = true; anyNewThreads; )
+    {
+        threadIndex.invalidate();
+        anyNewThreads = false;
+
+        for (auto&& [processInfo, processThreads, result] : std::views::zip(processes, threads, results))
+        {
+            if (!result.result) continue;
+            if (result.issued == std::chrono::steady_clock::time_point {}) result.issued = std::chrono::steady_clock::now();
+
+            auto newThreads = for_each_new_process_thread(*this, processInfo, threadIndex, processThreads, suspend_thread_and_wait, ResumeThread);
+            result.confirmed = std::chrono::steady_clock::now();
+
+            if (!newThreads)
+            {
+                result.result = make_error("{}", newThreads.error().message());
+                continue;
+            }
+
+            anyNewThreads = anyNewThreads || *newThreads;
+        }
+    }
+
+    return results;
+}
+
+std::vector<ProcessOperationResult> WindowsProcessController::resume(std::span<ProcessInfo const> processes)
+{
+    threadIndex.invalidate();
+
+    std::vector<ProcessOperationResult> results {};
+    results.reserve(processes.size());
+
+    for (auto const& processInfo : processes)
+    {
+        ProcessThreads threads {};
+        auto const resumed = for_each_new_process_thread(*this, processInfo, threadIndex, threads, ResumeThread, SuspendThread);
+        results.emplace_back(processInfo.pid, resumed ? Result<void> {} : make_error("{}", resumed.error().message()));
+    }
+
+    return results;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ProcessListener.hpp"
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/fake/FakeProcessBackend.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//
+// The engine's handlers wired up the way Main does, over the fake backend.
+// Tests hand the events over themselves, so they decide which of them the
+// engine gets to see and when.
+//
+struct Engine
+{
+    std::unordered_map<std::string, std::string> protectedPrograms {};
+    ProcessTable runningProcesses {};
+    ProcessTree processTree {};
+    std::unordered_set<ProcessId> unannouncedProcesses {};
+    SuspensionQueue suspensionQueue {};
+    ProcessTable suspendedProcesses {};
+    ProcessTable resumedProcesses {};
+    ProcessControllerBackend controller {};
+    std::unordered_map<ProcessId, EnforcementTrace> enforcementTraces {};
+    EnforcementLatency enforcementLatency {};
+    EventLog eventLog { 1024 };
+
+    ProcessListenerContext ctx {
+        protectedPrograms,
+        runningProcesses,
+        processTree,
+        unannouncedProcesses,
+        suspensionQueue,
+        suspendedProcesses,
+        resumedProcesses,
+        controller,
+        enforcementTraces,
+        enforcementLatency,
+        eventLog
+    };
+
+    void handle(std::vector<ProcessEvent> const& events)
+    {
+        for (auto const& event : events)
+        {
+            switch (event.kind)
+            {
+            case ProcessEvent::Kind::CREATED: process_creation_handler(ctx, ProcessInfo { std::string(event.name()), event.pid, event.parentPid }, event.receivedAt); break;
+            case ProcessEvent::Kind::DELETED: process_deletion_handler(ctx, ProcessInfo { std::string(event.name()), event.pid }); break;
+            case ProcessEvent::Kind::REPLACED: process_replacement_handler(ctx, ProcessInfo { std::string(event.name()), event.pid, event.parentPid }, event.receivedAt); break;
+            }
+        }
+
+        process_suspension_handler(ctx);
+    }
+
+    void rescan()
+    {
+        runningProcesses = fake_process_world().snapshot();
+        process_rescan_handler(ctx, runningProcesses);
+        process_suspension_handler(ctx);
+    }
+
+    std::size_t times_suspended(ProcessId pid) const
+    {
+        auto times = 0zu;
+        for (auto const& processes : suspendedProcesses | std::views::values) times += static_cast<std::size_t>(std::ranges::count(processes, pid, &ProcessInfo::pid));
+        return times;
+    }
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <source_location>
+
+//
+// The tests are plain executables run by CTest, a failed expectation prints
+// where it happened and exits with a failure right away.
+//
+inline void expect(bool condition, char const* expression, std::source_location location = std::source_location::current())
+{
+    if (condition) return;
+    fmt::print(stderr, "{}:{}: expected {}\n", location.file_name(), location.line(), expression);
+    std::exit(EXIT_FAILURE);
+}
+
+#define EXPECT(...) expect(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__)
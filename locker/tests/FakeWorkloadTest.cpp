@@ -0,0 +1,100 @@
+#include "Engine.hpp"
+#include "Expect.hpp"
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/fake/FakeProcessBackend.hpp"
+#include "os/process/fake/FakeProcessGenerator.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+//
+// Replays the workload in LOCKER_FAKE_WORKLOAD through the engine's handlers
+// as fast as the fake source can generate it, then checks that every process
+// running under a protected program, itself or through an ancestor, ended up
+// suspended. The throughput and the enforcement latencies are reported so a
+// regression shows up in the test log.
+//
+// The workload needs an event budget to ever finish; CTest sets one with
+// bursts and a low pid limit, so fork storms and pid reuse both happen.
+//
+static constexpr std::array<char const*, 2> PROTECTED_PROGRAMS { "program-0", "program-1" };
+
+int main()
+{
+    auto const* text = std::getenv("LOCKER_FAKE_WORKLOAD");
+    EXPECT(text != nullptr);
+    auto const workload = MUST(parse_fake_process_workload(text));
+    EXPECT(workload.events > 0);
+
+    ProcessEventQueue queue {};
+    FakeProcessSource source {};
+    Engine engine {};
+
+    for (auto const* program : PROTECTED_PROGRAMS) engine.protectedPrograms.emplace(program, "password");
+
+    MUST(source.start(queue));
+    engine.runningProcesses = MUST(source.scan());
+    engine.processTree.reconcile(engine.runningProcesses);
+
+    std::uint64_t handled = 0;
+    std::uint64_t droppedEvents = 0;
+    auto const startedAt = std::chrono::steady_clock::now();
+
+    // the replay flags itself finished only after its last events went in, so one more drain after that gets them all.
+    for (auto finished = false; !finished;)
+    {
+        finished = source.finished();
+
+        auto const& events = queue.drain();
+        handled += events.size();
+        engine.handle(events);
+
+        // what Main does when the queue overflows, the dropped events can only be made up for by a rescan.
+        if (auto const dropped = queue.statistics().dropped; dropped != droppedEvents)
+        {
+            droppedEvents = dropped;
+            engine.rescan();
+        }
+
+        if (events.empty()) std::this_thread::yield();
+    }
+
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt);
+    source.stop();
+
+    auto const statistics = queue.statistics();
+    fmt::print(
+        "{} events handled in {:.2f}s, {:.0f} events/s, {} dropped, high watermark {}\n",
+        handled,
+        elapsed.count(),
+        static_cast<double>(handled) / elapsed.count(),
+        statistics.dropped,
+        statistics.highWatermark
+    );
+    log_enforcement_latency(engine.enforcementLatency);
+
+    auto protectedCount = 0zu;
+    for (auto const& process : fake_process_world().snapshot() | std::views::values | std::views::join)
+    {
+        auto const lockedBy = engine.processTree.find_ancestor(process.pid, [&] (ProcessId, std::string const& name) {
+            return engine.protectedPrograms.contains(name);
+        });
+        if (!lockedBy) continue;
+
+        protectedCount += 1;
+        if (!fake_process_world().is_suspended(process.pid))
+        {
+            fmt::print(stderr, "{} ({}) runs under {} but isn't suspended\n", process.name, process.pid, engine.processTree.name(*lockedBy));
+        }
+        EXPECT(fake_process_world().is_suspended(process.pid));
+    }
+
+    fmt::print("{} protected processes running, all suspended\n", protectedCount);
+    EXPECT(protectedCount > 0);
+    EXPECT(engine.enforcementLatency.total.count() > 0);
+}
@@ -0,0 +1,87 @@
+#include "BakedFontAtlas.hpp"
+#include "Expect.hpp"
+
+#include "imgui/imgui.h"
+
+#include <liberror/Try.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+//
+// Builds the font atlas the way startup does with ENABLE_BAKED_FONT_ATLAS off,
+// rasterizing the default font and expanding it to RGBA32, and the way it does
+// with the option on, decoding the baked one, then checks the backend would be
+// handed the same texture and glyphs either way. Both are timed over ROUNDS
+// fresh atlases each and the medians printed, since the texture upload that
+// follows is the same for both and needs a window this test doesn't have.
+//
+static constexpr auto ROUNDS = 200;
+
+struct AtlasTexture
+{
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+};
+
+static AtlasTexture texture_of(ImFontAtlas& atlas)
+{
+    AtlasTexture texture {};
+    atlas.GetTexDataAsRGBA32(&texture.pixels, &texture.width, &texture.height);
+    return texture;
+}
+
+static double median_microseconds(std::vector<std::chrono::nanoseconds>& times)
+{
+    std::ranges::nth_element(times, times.begin() + static_cast<std::ptrdiff_t>(times.size() / 2));
+    return std::chrono::duration<double, std::micro>(times[times.size() / 2]).count();
+}
+
+int main()
+{
+    ImFontAtlas built {};
+    ImFontAtlas baked {};
+    MUST(load_baked_font_atlas(baked, BAKED_FONT_ATLAS));
+
+    auto const builtTexture = texture_of(built);
+    auto const bakedTexture = texture_of(baked);
+
+    EXPECT(builtTexture.width == bakedTexture.width);
+    EXPECT(builtTexture.height == bakedTexture.height);
+    EXPECT(std::memcmp(builtTexture.pixels, bakedTexture.pixels, static_cast<std::size_t>(builtTexture.width * builtTexture.height) * 4) == 0);
+
+    auto const& builtFont = *built.Fonts[0];
+    auto const& bakedFont = *baked.Fonts[0];
+    EXPECT(builtFont.Glyphs.Size == bakedFont.Glyphs.Size);
+    EXPECT(builtFont.FontSize == bakedFont.FontSize);
+    EXPECT(std::memcmp(builtFont.Glyphs.Data, bakedFont.Glyphs.Data, static_cast<std::size_t>(builtFont.Glyphs.size_in_bytes())) == 0);
+
+    std::vector<std::chrono::nanoseconds> buildTimes {};
+    std::vector<std::chrono::nanoseconds> loadTimes {};
+
+    for (auto round = 0; round < ROUNDS; round += 1)
+    {
+        ImFontAtlas runtimeAtlas {};
+        auto const buildStartedAt = std::chrono::steady_clock::now();
+        texture_of(runtimeAtlas);
+        buildTimes.push_back(std::chrono::steady_clock::now() - buildStartedAt);
+
+        ImFontAtlas bakedAtlas {};
+        auto const loadStartedAt = std::chrono::steady_clock::now();
+        MUST(load_baked_font_atlas(bakedAtlas, BAKED_FONT_ATLAS));
+        texture_of(bakedAtlas);
+        loadTimes.push_back(std::chrono::steady_clock::now() - loadStartedAt);
+    }
+
+    fmt::print(
+        "{}x{} atlas, built at runtime in {:.1f}us, loaded baked in {:.1f}us (medians of {})\n",
+        builtTexture.width,
+        builtTexture.height,
+        median_microseconds(buildTimes),
+        median_microseconds(loadTimes),
+        ROUNDS
+    );
+}
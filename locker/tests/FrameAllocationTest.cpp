@@ -0,0 +1,174 @@
+#include "AllocationCounter.hpp"
+#include "EventLog.hpp"
+#include "Expect.hpp"
+#include "TableRows.hpp"
+#include "os/process/ProcessTree.hpp"
+
+#include "imgui/imgui.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//
+// Builds frames with every table of the UI holding far more rows than fit on
+// screen, scrolled to a different spot every frame. The first passes let
+// ImGui's buffers grow to fit (the table's draw channels trade buffers between
+// columns, so that takes more than one), then one more over the same spots,
+// with the processes replaced by new ones, must not allocate anything at all
+// while the rows are submitted.
+//
+static constexpr auto ROW_COUNT = 100'000;
+static constexpr auto WARM_UP_PASSES = 2;
+static constexpr auto FRAMES_PER_PASS = 60;
+static constexpr auto SCROLL_STEP = 997.0f;
+
+struct Tables
+{
+    std::unordered_map<std::string, std::vector<ProcessInfo>> processes {};
+    std::vector<ProcessGroup const*> processRows {};
+    ProcessUsageSnapshot usage {};
+    ProcessTree tree {};
+    std::vector<ProcessTreeRow> treeRows {};
+    std::unordered_set<ProcessId> expanded {};
+    ImGuiStorage treeNodeState {};
+    std::unordered_map<std::string, std::string> programs {};
+    std::vector<ProtectedProgram const*> programRows {};
+    EventLog eventLog {};
+    std::chrono::steady_clock::time_point startedAt = std::chrono::steady_clock::now();
+};
+
+// every fourth process starts the three after it, and the pids of a generation never collide with another's.
+static void populate(Tables& tables, ProcessId generation)
+{
+    tables.processes.clear();
+    tables.usage = {};
+    tables.tree = {};
+    tables.expanded.clear();
+
+    for (auto i = 0; i < ROW_COUNT; i += 1)
+    {
+        auto const pid = static_cast<ProcessId>(i * 4 + 4) + generation;
+        auto const parentPid = i % 4 == 0 ? ProcessTree::ROOT : pid - static_cast<ProcessId>(i % 4 * 4);
+        auto const name = "process_" + std::to_string(i) + ".exe";
+
+        tables.processes[name].push_back({ name, pid, parentPid });
+        tables.tree.insert(pid, parentPid, name);
+        tables.expanded.insert(pid);
+
+        tables.usage.slots.emplace(pid, static_cast<std::uint32_t>(tables.usage.samples.size()));
+        tables.usage.samples.push_back({ .pid = pid, .cpuPercent = static_cast<float>(i % 1000) / 10.0f, .residentBytes = pid * 4096ull, .hasRate = true });
+    }
+
+    tables.processRows.clear();
+    for (auto const& process : tables.processes) tables.processRows.push_back(&process);
+
+    std::vector<ProcessTreeRow> pending {};
+    flatten_process_tree(tables.tree, tables.expanded, tables.treeRows, pending);
+    reserve_node_state(tables.treeNodeState, tables.treeRows.size());
+}
+
+// the allocations made while fnRows submitted the rows of a table set up like the UI's.
+static std::uint64_t table(char const* name, int columns, float scroll, auto&& fnRows)
+{
+    std::uint64_t allocations = 0;
+
+    ImGui::SetNextWindowSize({ 640.0f, 400.0f });
+    if (ImGui::Begin(name) && ImGui::BeginTable(name, columns, ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        for (auto column = 0; column < columns; column += 1) ImGui::TableSetupColumn("Column");
+        ImGui::TableHeadersRow();
+        ImGui::SetScrollY(scroll);
+
+        auto const start = allocation_count();
+        fnRows();
+        allocations = allocation_count() - start;
+
+        ImGui::EndTable();
+    }
+    ImGui::End();
+
+    return allocations;
+}
+
+static std::uint64_t frame(Tables& tables, float scroll)
+{
+    std::uint64_t allocations = 0;
+    VisibleRanges visible {};
+
+    ImGui::NewFrame();
+
+    allocations += table("Processes", 4, scroll, [&] {
+        process_table_rows(tables.processRows, tables.usage, 7, visible);
+    });
+
+    allocations += table("Process Tree", 4, scroll, [&] {
+        process_tree_rows(tables.tree, tables.treeRows, tables.expanded, tables.treeRows.front().pid, tables.usage, tables.treeNodeState, visible);
+    });
+
+    allocations += table("Protected Programs", 2, scroll, [&] {
+        protected_program_rows(tables.programRows, 7);
+    });
+
+    allocations += table("Event Log", 4, scroll, [&] {
+        event_log_rows(tables.eventLog, tables.startedAt);
+    });
+
+    ImGui::Render();
+
+    return allocations;
+}
+
+int main()
+{
+    ImGui::SetAllocatorFunctions(counted_malloc, counted_free);
+    ImGui::CreateContext();
+
+    auto& io = ImGui::GetIO();
+    io.DisplaySize = { 1280.0f, 800.0f };
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+
+    // no renderer is attached, but NewFrame still wants the atlas built.
+    unsigned char* pixels {};
+    int width {};
+    int height {};
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    Tables tables {};
+    populate(tables, 0);
+
+    for (auto i = 0; i < ROW_COUNT; i += 1)
+    {
+        auto const name = "program_" + std::to_string(i) + ".exe";
+        tables.eventLog.push(EventLogKind::STARTED, static_cast<ProcessId>(i), name);
+        tables.programs.emplace(name, "password");
+    }
+
+    for (auto const& program : tables.programs) tables.programRows.push_back(&program);
+
+    for (auto pass = 0; pass < WARM_UP_PASSES; pass += 1)
+    {
+        for (auto i = 0; i < FRAMES_PER_PASS; i += 1)
+        {
+            frame(tables, static_cast<float>(i) * SCROLL_STEP);
+        }
+    }
+
+    // new pids mean tree nodes ImGui has never seen, which is what used to grow its state storage.
+    populate(tables, 1);
+
+    std::uint64_t allocations = 0;
+    for (auto i = 0; i < FRAMES_PER_PASS; i += 1)
+    {
+        allocations += frame(tables, static_cast<float>(i) * SCROLL_STEP);
+    }
+
+    EXPECT(allocations == 0);
+
+    ImGui::DestroyContext();
+}
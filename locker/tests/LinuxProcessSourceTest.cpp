@@ -0,0 +1,142 @@
+#include "Expect.hpp"
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/linux/LinuxProcessBackend.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+//
+// Forks CHILDREN processes that wait on a pipe, lets them all go at once, and
+// checks that the source reported every creation, with us as the parent, and
+// every exit. The cost per event is the CPU time the source's listener thread
+// spent, as the scheduler accounts it, over every event it delivered, ours and
+// the rest of the system's alike. Whichever mechanism the source could get is
+// the one measured: the BPF trace as root, the process connector with only
+// CAP_NET_ADMIN, polling /proc otherwise.
+//
+static constexpr auto CHILDREN = 2000;
+
+// nanoseconds on a cpu for every thread of ours but this one, the first field of /proc/self/task/<tid>/schedstat.
+static std::uint64_t listener_cpu_time()
+{
+    auto* directory = opendir("/proc/self/task");
+    if (directory == nullptr) return 0;
+
+    std::uint64_t total = 0;
+    auto const self = std::to_string(gettid());
+
+    while (auto* entry = readdir(directory))
+    {
+        std::string_view const tid { entry->d_name };
+        if (tid.starts_with('.') || tid == self) continue;
+
+        std::array<char, 128> buffer {};
+        auto file = open(fmt::format("/proc/self/task/{}/schedstat", tid).c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0) continue;
+        auto const bytes = read(file, buffer.data(), buffer.size());
+        close(file);
+
+        std::uint64_t nanoseconds = 0;
+        if (bytes > 0 && std::from_chars(buffer.data(), buffer.data() + bytes, nanoseconds).ec == std::errc {}) total += nanoseconds;
+    }
+
+    closedir(directory);
+    return total;
+}
+
+int main()
+{
+    ProcessEventQueue queue {};
+    LinuxProcessSource source {};
+    MUST(source.start(queue));
+
+    std::array<int, 2> gate {};
+    EXPECT(pipe2(gate.data(), O_CLOEXEC) == 0);
+
+    std::unordered_set<ProcessId> children {};
+    std::unordered_set<ProcessId> created {};
+    std::unordered_set<ProcessId> exited {};
+    std::uint64_t events = 0;
+
+    auto const fnDrainUntil = [&] (auto&& fnDone) {
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+        while (!fnDone() && std::chrono::steady_clock::now() < deadline)
+        {
+            auto const& drained = queue.drain();
+            events += drained.size();
+
+            for (auto const& event : drained)
+            {
+                if (!children.contains(event.pid)) continue;
+
+                if (event.kind == ProcessEvent::Kind::CREATED)
+                {
+                    EXPECT(event.parentPid == static_cast<ProcessId>(getpid()));
+                    created.insert(event.pid);
+                }
+                else if (event.kind == ProcessEvent::Kind::DELETED)
+                {
+                    exited.insert(event.pid);
+                }
+            }
+
+            if (drained.empty()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    auto const cpuTimeBefore = listener_cpu_time();
+    auto const startedAt = std::chrono::steady_clock::now();
+
+    for (auto child = 0; child < CHILDREN; child += 1)
+    {
+        auto const pid = fork();
+        EXPECT(pid >= 0);
+
+        if (pid == 0)
+        {
+            // only async-signal-safe calls from here on, the parent has threads.
+            close(gate[1]);
+            char byte {};
+            [[maybe_unused]] auto const _ = read(gate[0], &byte, 1);
+            _exit(0);
+        }
+
+        children.insert(static_cast<ProcessId>(pid));
+    }
+
+    fnDrainUntil([&] { return created.size() == children.size(); });
+
+    // every child's read returns once the last write end is gone.
+    close(gate[0]);
+    close(gate[1]);
+    for (auto const pid : children) waitpid(static_cast<pid_t>(pid), nullptr, 0);
+
+    fnDrainUntil([&] { return exited.size() == children.size(); });
+
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt);
+    auto const cpuTime = listener_cpu_time() - cpuTimeBefore;
+    source.stop();
+
+    fmt::print(
+        "{} events in {:.2f}s, {:.0f} events/s, {:.2f}us of listener time per event, {} dropped\n",
+        events,
+        elapsed.count(),
+        static_cast<double>(events) / elapsed.count(),
+        static_cast<double>(cpuTime) / 1000.0 / static_cast<double>(events),
+        queue.statistics().dropped
+    );
+
+    EXPECT(created.size() == children.size());
+    EXPECT(exited.size() == children.size());
+}
@@ -0,0 +1,113 @@
+#include "Expect.hpp"
+#include "PersistentMemoizer.hpp"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <csignal>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+static constexpr std::uint32_t SCHEMA_VERSION = 1;
+static constexpr std::uint64_t FIBONACCI_90 = 2880067194370816120;
+
+static auto open_fibonacci(std::filesystem::path const& path)
+{
+    return MUST(make_persistent_memoizer<std::uint64_t(std::uint64_t)>(path, SCHEMA_VERSION, [] (auto& self, std::uint64_t n) -> std::uint64_t {
+        return n < 2 ? n : self(n - 1) + self(n - 2);
+    }));
+}
+
+static void fill(std::filesystem::path const& path)
+{
+    std::filesystem::remove(path);
+
+    auto memoizer = open_fibonacci(path);
+    EXPECT(memoizer(90) == FIBONACCI_90);
+    EXPECT(memoizer.size() == 91);
+    MUST(memoizer.flush());
+}
+
+static void reopens_with_its_results(std::filesystem::path const& path)
+{
+    fill(path);
+
+    auto memoizer = open_fibonacci(path);
+    EXPECT(memoizer.size() == 91);
+    EXPECT(memoizer(90) == FIBONACCI_90);
+}
+
+static void reformats_a_truncated_file(std::filesystem::path const& path)
+{
+    fill(path);
+
+    // the header survives and still claims the whole table, but the slots it points at are gone.
+    std::filesystem::resize_file(path, 64);
+
+    auto memoizer = open_fibonacci(path);
+    EXPECT(memoizer.size() == 0);
+    EXPECT(memoizer(90) == FIBONACCI_90);
+    EXPECT(memoizer.size() == 91);
+}
+
+static void reformats_a_capacity_that_would_overflow(std::filesystem::path const& path)
+{
+    fill(path);
+
+    // a power of two, so only the size check stands between it and the lookups.
+    constexpr std::uint64_t CAPACITY = std::uint64_t { 1 } << 62;
+    std::fstream file { path, std::ios::binary | std::ios::in | std::ios::out };
+    file.seekp(16);
+    file.write(reinterpret_cast<char const*>(&CAPACITY), sizeof(CAPACITY));
+    file.close();
+
+    auto memoizer = open_fibonacci(path);
+    EXPECT(memoizer.size() == 0);
+    EXPECT(memoizer(90) == FIBONACCI_90);
+}
+
+#ifndef _WIN32
+// the file is capped at the size it has, so the table can't grow and has to keep working in the mapping it already has.
+static void keeps_its_table_when_the_file_cant_grow(std::filesystem::path const& path)
+{
+    fill(path);
+
+    auto memoizer = open_fibonacci(path);
+
+    rlimit limit {};
+    EXPECT(getrlimit(RLIMIT_FSIZE, &limit) == 0);
+    auto const capped = rlimit { static_cast<rlim_t>(std::filesystem::file_size(path)), limit.rlim_max };
+    EXPECT(setrlimit(RLIMIT_FSIZE, &capped) == 0);
+    auto const previousHandler = std::signal(SIGXFSZ, SIG_IGN);
+
+    // just past the 768 results the default table holds before it grows; whatever doesn't fit is computed over again, so not much further.
+    constexpr std::uint64_t N = 780;
+    std::uint64_t previous = 0;
+    std::uint64_t current = 1;
+    for (auto i = 1zu; i < N; i += 1) previous = std::exchange(current, previous + current);
+
+    EXPECT(memoizer(N) == current);
+    EXPECT(memoizer.size() < N + 1);
+    EXPECT(memoizer(90) == FIBONACCI_90);
+
+    std::signal(SIGXFSZ, previousHandler);
+    EXPECT(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+}
+#endif
+
+int main()
+{
+    auto const path = std::filesystem::temp_directory_path() / "locker_persistent_memoizer_test.bin";
+
+    reopens_with_its_results(path);
+    reformats_a_truncated_file(path);
+    reformats_a_capacity_that_would_overflow(path);
+#ifndef _WIN32
+    keeps_its_table_when_the_file_cant_grow(path);
+#endif
+
+    std::filesystem::remove(path);
+}
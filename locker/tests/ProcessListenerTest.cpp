@@ -0,0 +1,166 @@
+#include "Engine.hpp"
+#include "Expect.hpp"
+#include "os/process/ProcessEventQueue.hpp"
+#include "os/process/fake/FakeProcessBackend.hpp"
+
+#include <string>
+#include <vector>
+
+static std::vector<std::string> const PROGRAMS { "idle", "protected" };
+static constexpr std::uint32_t IDLE = 0;
+static constexpr std::uint32_t PROTECTED = 1;
+
+static void create(std::vector<FakeProcessAction>& actions, ProcessId pid, ProcessId parentPid, std::uint32_t program)
+{
+    actions.push_back({ ProcessEvent::Kind::CREATED, pid, parentPid, program, {} });
+}
+
+// every test starts from an empty world that pushes into its own queue.
+static void reset_world(ProcessEventQueue* queue)
+{
+    std::vector<FakeProcessAction> actions {};
+    for (auto const& process : fake_process_world().snapshot() | std::views::values | std::views::join)
+    {
+        actions.push_back({ ProcessEvent::Kind::DELETED, process.pid, 0, 0, {} });
+    }
+
+    fake_process_world().attach(nullptr);
+    fake_process_world().apply(actions, PROGRAMS);
+    fake_process_world().attach(queue);
+}
+
+static void locks_what_the_queue_dropped()
+{
+    ProcessEventQueue queue { 4 };
+    reset_world(&queue);
+
+    Engine engine {};
+    engine.protectedPrograms.emplace(PROGRAMS[PROTECTED], "password");
+
+    // nobody drains while the burst goes in, so everything past the first few events is dropped.
+    std::vector<FakeProcessAction> actions {};
+    for (ProcessId pid = 1; pid < 64; pid += 1) create(actions, pid, 0, IDLE);
+    create(actions, 64, 0, PROTECTED);
+    create(actions, 65, 64, IDLE);
+    fake_process_world().apply(actions, PROGRAMS);
+
+    EXPECT(queue.statistics().dropped >= 60);
+
+    engine.handle(queue.drain());
+    EXPECT(!fake_process_world().is_suspended(64));
+
+    engine.rescan();
+    EXPECT(fake_process_world().is_suspended(64));
+    EXPECT(fake_process_world().is_suspended(65));
+    EXPECT(!fake_process_world().is_suspended(1));
+}
+
+static void suspends_a_process_seen_twice_once()
+{
+    ProcessEventQueue queue {};
+    reset_world(&queue);
+
+    Engine engine {};
+    engine.protectedPrograms.emplace(PROGRAMS[PROTECTED], "password");
+
+    std::vector<FakeProcessAction> actions {};
+    create(actions, 7, 0, PROTECTED);
+    fake_process_world().apply(actions, PROGRAMS);
+
+    // the rescan finds the process while its event is still queued.
+    engine.rescan();
+    engine.handle(queue.drain());
+
+    EXPECT(engine.suspensionQueue.empty());
+    EXPECT(engine.times_suspended(7) == 1);
+}
+
+static void forgets_an_exit_the_queue_dropped()
+{
+    ProcessEventQueue queue { 4 };
+    reset_world(&queue);
+
+    Engine engine {};
+    engine.protectedPrograms.emplace(PROGRAMS[PROTECTED], "password");
+
+    std::vector<FakeProcessAction> actions {};
+    create(actions, 9, 0, PROTECTED);
+    fake_process_world().apply(actions, PROGRAMS);
+    engine.handle(queue.drain());
+    EXPECT(engine.times_suspended(9) == 1);
+
+    actions.clear();
+    for (ProcessId pid = 10; pid < 74; pid += 1) create(actions, pid, 0, IDLE);
+    actions.push_back({ ProcessEvent::Kind::DELETED, 9, 0, 0, {} });
+    fake_process_world().apply(actions, PROGRAMS);
+    engine.handle(queue.drain());
+
+    engine.rescan();
+    EXPECT(!engine.processTree.contains(9));
+    EXPECT(engine.suspendedProcesses.empty());
+}
+
+static void replace(std::vector<FakeProcessAction>& actions, ProcessId pid, std::uint32_t program)
+{
+    actions.push_back({ ProcessEvent::Kind::REPLACED, pid, 0, program, {} });
+}
+
+static void locks_an_exec_into_a_protected_program()
+{
+    ProcessEventQueue queue {};
+    reset_world(&queue);
+
+    Engine engine {};
+    engine.protectedPrograms.emplace(PROGRAMS[PROTECTED], "password");
+
+    std::vector<FakeProcessAction> actions {};
+    create(actions, 20, 0, IDLE);
+    create(actions, 21, 20, IDLE);
+    fake_process_world().apply(actions, PROGRAMS);
+    engine.handle(queue.drain());
+    EXPECT(!fake_process_world().is_suspended(20));
+
+    actions.clear();
+    replace(actions, 20, PROTECTED);
+    fake_process_world().apply(actions, PROGRAMS);
+    engine.handle(queue.drain());
+
+    EXPECT(fake_process_world().is_suspended(20));
+    EXPECT(engine.processTree.name(20) == PROGRAMS[PROTECTED]);
+    EXPECT(engine.processTree.children(20).size() == 1);
+}
+
+static void keeps_a_forked_child_locked_through_its_exec()
+{
+    ProcessEventQueue queue {};
+    reset_world(&queue);
+
+    Engine engine {};
+    engine.protectedPrograms.emplace(PROGRAMS[PROTECTED], "password");
+
+    // a fork without an exec yet, the child still runs the parent's program.
+    std::vector<FakeProcessAction> actions {};
+    create(actions, 30, 0, PROTECTED);
+    create(actions, 31, 30, PROTECTED);
+    fake_process_world().apply(actions, PROGRAMS);
+    engine.handle(queue.drain());
+    EXPECT(fake_process_world().is_suspended(31));
+
+    actions.clear();
+    replace(actions, 31, IDLE);
+    fake_process_world().apply(actions, PROGRAMS);
+    engine.handle(queue.drain());
+
+    EXPECT(fake_process_world().is_suspended(31));
+    EXPECT(engine.suspensionQueue.empty());
+    EXPECT(engine.times_suspended(31) == 1);
+}
+
+int main()
+{
+    locks_what_the_queue_dropped();
+    suspends_a_process_seen_twice_once();
+    forgets_an_exit_the_queue_dropped();
+    locks_an_exec_into_a_protected_program();
+    keeps_a_forked_child_locked_through_its_exec();
+}
@@ -0,0 +1,108 @@
+//
+// Builds the font atlas the frontend would otherwise build on every startup
+// and writes it out as a C++ source defining BAKED_FONT_ATLAS (see
+// BakedFontAtlas.hpp). It builds with the same ImGui sources and defaults as
+// locker itself, so the glyphs and UVs it captures are exactly the ones
+// ImGui would have come up with.
+//
+
+#include "imgui/imgui.h"
+
+#include <fmt/format.h>
+#include <fmt/os.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <span>
+#include <vector>
+
+static std::vector<std::uint8_t> encode_run_lengths(std::span<unsigned char const> alpha)
+{
+    std::vector<std::uint8_t> runs {};
+
+    for (auto pixel = 0zu; pixel < alpha.size();)
+    {
+        auto const value = alpha[pixel];
+        auto length = 1zu;
+        while (length < 255 && pixel + length < alpha.size() && alpha[pixel + length] == value) length += 1;
+
+        runs.push_back(static_cast<std::uint8_t>(length));
+        runs.push_back(value);
+        pixel += length;
+    }
+
+    return runs;
+}
+
+int main(int argc, char const** argv)
+{
+    if (argc != 2)
+    {
+        fmt::print(stderr, "usage: {} <output.cpp>\n", argv[0]);
+        return 1;
+    }
+
+    ImFontAtlas atlas {};
+    atlas.AddFontDefault();
+
+    unsigned char* pixels = nullptr;
+    auto width = 0;
+    auto height = 0;
+    atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    auto const& font = *atlas.Fonts[0];
+    auto const runs = encode_run_lengths({ pixels, static_cast<std::size_t>(width) * static_cast<std::size_t>(height) });
+
+    try
+    {
+        auto output = fmt::output_file(argv[1]);
+
+        output.print("// generated by font_atlas_baker, do not edit.\n\n");
+        output.print("#include \"BakedFontAtlas.hpp\"\n\n");
+
+        // hexadecimal float literals, so every value survives the trip exactly.
+        output.print("static constexpr float LINES[] = {{\n");
+        for (auto const& line : atlas.TexUvLines)
+        {
+            output.print("    {:a}f, {:a}f, {:a}f, {:a}f,\n", line.x, line.y, line.z, line.w);
+        }
+        output.print("}};\n\n");
+
+        // the tab glyph is left out, BuildLookupTable() derives it from the space.
+        output.print("static constexpr BakedFontGlyph GLYPHS[] = {{\n");
+        for (auto const& glyph : font.Glyphs)
+        {
+            if (glyph.Codepoint == '\t') continue;
+            output.print(
+                "    {{ {}, {}, {}, {:a}f, {:a}f, {:a}f, {:a}f, {:a}f, {:a}f, {:a}f, {:a}f, {:a}f }},\n",
+                static_cast<unsigned int>(glyph.Codepoint), glyph.Colored != 0, glyph.Visible != 0, glyph.AdvanceX,
+                glyph.X0, glyph.Y0, glyph.X1, glyph.Y1, glyph.U0, glyph.V0, glyph.U1, glyph.V1
+            );
+        }
+        output.print("}};\n\n");
+
+        output.print("static constexpr std::uint8_t PIXELS[] = {{");
+        for (auto index = 0zu; index < runs.size(); index += 1)
+        {
+            output.print("{}{},", index % 32 == 0 ? "\n    " : " ", runs[index]);
+        }
+        output.print("\n}};\n\n");
+
+        output.print("BakedFontAtlas const BAKED_FONT_ATLAS {{\n");
+        output.print("    .width = {},\n    .height = {},\n", width, height);
+        output.print("    .fontSize = {:a}f,\n    .ascent = {:a}f,\n    .descent = {:a}f,\n", font.FontSize, font.Ascent, font.Descent);
+        output.print("    .whitePixel = {{ {:a}f, {:a}f }},\n", atlas.TexUvWhitePixel.x, atlas.TexUvWhitePixel.y);
+        output.print("    .lines = LINES,\n    .glyphs = GLYPHS,\n    .pixels = PIXELS,\n");
+        output.print("}};\n");
+    }
+    catch (std::exception const& error)
+    {
+        fmt::print(stderr, "couldn't write {}: {}\n", argv[1], error.what());
+        return 1;
+    }
+
+    fmt::print("baked a {}x{} font atlas with {} glyphs into {} bytes\n", width, height, font.Glyphs.Size, runs.size());
+
+    return 0;
+}